@@ -3,6 +3,8 @@
 #include <string>
 #include <vector>
 #include <random>
+#include <memory>
+#include <thread>
 
 // Test data generators
 namespace BenchmarkData {
@@ -549,4 +551,436 @@ BENCHMARK_F(HeadlessNcursesFixture, BM_CursesWwrapWithTokens_Fixed_MultiByte)(be
     }
 }
 
+// ==== MULTI-PANE FRAME BENCHMARKS (serial curses_wprint vs FramePipeline) ====
+// Each pane gets a fresh block of wrapped, token-styled text every frame; Arg = pane count.
+
+namespace PaneBenchmarkData {
+    std::string paneText(int pane) {
+        std::string text;
+        for (int i = 0; i < 12; ++i) {
+            text += "pane " + std::to_string(pane) + " entry {" + std::to_string(i) + "}$[bold=true] "
+                  + "with enough words to wrap across several rows of the pane. ";
+        }
+        return text;
+    }
+}
+
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_Panes_SerialWprint)(benchmark::State& state) {
+    int paneCount = static_cast<int>(state.range(0));
+    std::vector<WINDOW*> panes;
+    std::vector<std::string> texts;
+    for (int i = 0; i < paneCount; ++i) {
+        panes.push_back(newwin(12, 40, (i / 2) * 12 % 24, (i % 2) * 40));
+        texts.push_back(PaneBenchmarkData::paneText(i));
+    }
+    std::unordered_map<std::string,std::string> format = {{"wrap", "true"}};
+    for (auto _ : state) {
+        for (int i = 0; i < paneCount; ++i) {
+            werase(panes[i]);
+            stevensTerminal::PrintHelper::curses_wprint(panes[i], 0, 0, texts[i], {}, format, true);
+            wnoutrefresh(panes[i]);
+        }
+        doupdate();
+    }
+    for (WINDOW* pane : panes) delwin(pane);
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_Panes_SerialWprint)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_Panes_FramePipeline)(benchmark::State& state) {
+    int paneCount = static_cast<int>(state.range(0));
+    std::vector<WINDOW*> panes;
+    std::vector<std::string> texts;
+    for (int i = 0; i < paneCount; ++i) {
+        panes.push_back(newwin(12, 40, (i / 2) * 12 % 24, (i % 2) * 40));
+        texts.push_back(PaneBenchmarkData::paneText(i));
+    }
+    std::unordered_map<std::string,std::string> format = {{"wrap", "true"}};
+    stevensTerminal::FramePipeline pipeline;
+    for (auto _ : state) {
+        for (int i = 0; i < paneCount; ++i) {
+            pipeline.beginPane(panes[i]);
+            pipeline.print(panes[i], 0, 0, texts[i], {}, format);
+        }
+        pipeline.renderFrame();
+    }
+    for (WINDOW* pane : panes) delwin(pane);
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_Panes_FramePipeline)->RangeMultiplier(2)->Range(1, 16)->UseRealTime();
+
+// ==== PARTICLE UPDATE BENCHMARKS ====
+// One 60 fps physics step over N live particles (lifetimes long enough that none die mid-run).
+// AoS_Reference steps a std::vector<Particle> one particle at a time, the way ParticleEffect used
+// to; SoA runs ParticleEffect::update() over its structure-of-arrays storage.
+
+namespace ParticleBenchmarkData {
+    stevensTerminal::ParticleFX::Particle prototype() {
+        stevensTerminal::ParticleFX::Particle p;
+        p.setPhysics(stevensTerminal::ParticleFX::ParticlePresets::Confetti());
+        p.setLifetime(1.0e9f);
+        return p;
+    }
+}
+
+static void BM_ParticleUpdate_AoS_Reference(benchmark::State& state) {
+    using namespace stevensTerminal::ParticleFX;
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> velocity(-10.0f, 10.0f);
+    std::vector<Particle> particles(state.range(0), ParticleBenchmarkData::prototype());
+    for (Particle& p : particles) {
+        p.setPosition(40.0f, 12.0f);
+        p.setVelocity(velocity(rng), velocity(rng));
+    }
+    for (auto _ : state) {
+        for (Particle& p : particles) {
+            p.update(1.0f / 60.0f, rng);
+            p.handleBoundaries(0, 80, 0, 24);
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParticleUpdate_AoS_Reference)->Arg(1000)->Arg(10000)->Arg(100000);
+
+static void BM_ParticleUpdate_SoA(benchmark::State& state) {
+    using namespace stevensTerminal::ParticleFX;
+    ParticleEffect effect(nullptr, 42);
+    effect.spawnBurst(Vec2(40.0f, 12.0f), static_cast<int>(state.range(0)), ParticleBenchmarkData::prototype());
+    for (auto _ : state) {
+        effect.update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParticleUpdate_SoA)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// Sustained effect: every frame spawns a wave and expires an older one (~Arg live particles)
+static void BM_ParticleSustained(benchmark::State& state) {
+    using namespace stevensTerminal::ParticleFX;
+    Particle spark = ParticleBenchmarkData::prototype();
+    spark.setLifetime(1.0f);
+    int perFrame = static_cast<int>(state.range(0) / 60);
+    ParticleEffect effect(nullptr, 42);
+    for (auto _ : state) {
+        effect.spawnBurst(Vec2(40.0f, 12.0f), perFrame, spark);
+        effect.update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * perFrame);
+}
+BENCHMARK(BM_ParticleSustained)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// Turbulence noise for 10k particles: std::mt19937 + uniform_real_distribution vs ParticleRng
+static void BM_ParticleNoise_Mt19937(benchmark::State& state) {
+    std::mt19937 rng(42);
+    std::vector<float> noise(20000);
+    for (auto _ : state) {
+        std::uniform_real_distribution<float> dist(-0.1f, 0.1f);
+        for (float& value : noise) value = dist(rng);
+        benchmark::DoNotOptimize(noise.data());
+    }
+}
+BENCHMARK(BM_ParticleNoise_Mt19937);
+
+static void BM_ParticleNoise_ParticleRng(benchmark::State& state) {
+    stevensTerminal::ParticleFX::ParticleRng rng(42);
+    std::vector<float> noise(20000);
+    for (auto _ : state) {
+        rng.fillUniform(noise.data(), noise.size(), -0.1f, 0.1f);
+        benchmark::DoNotOptimize(noise.data());
+    }
+}
+BENCHMARK(BM_ParticleNoise_ParticleRng);
+
+// Per-frame cost of a 50-particle effect over a full 80x24 window: restoring the whole snapshot
+// vs restoring only the cells the particles drew on last frame
+static void particleFrameBenchmark(benchmark::State& state, WINDOW* win, bool wholeWindow) {
+    using namespace stevensTerminal::ParticleFX;
+    for (int y = 0; y < 24; ++y) mvwprintw(win, y, 0, "%s", std::string(80, 'a' + y % 26).c_str());
+    ParticleWindowRegistry::registerWindow(win);
+    Particle spark = ParticleBenchmarkData::prototype();
+    spark.setModifyChar(true);
+    spark.setCharacter('*');
+    ParticleEffect effect(win, 42);
+    effect.spawnBurst(Vec2(40.0f, 12.0f), 50, spark);
+    for (auto _ : state) {
+        if (wholeWindow) ParticleWindowRegistry::restoreWindow(win);
+        else ParticleWindowRegistry::restoreTouched(win);
+        effect.update(1.0f / 60.0f);
+        effect.render();
+    }
+    ParticleWindowRegistry::unregisterWindow(win);
+}
+
+BENCHMARK_F(HeadlessNcursesFixture, BM_ParticleFrame_RestoreWholeWindow)(benchmark::State& state) {
+    particleFrameBenchmark(state, win, true);
+}
+
+BENCHMARK_F(HeadlessNcursesFixture, BM_ParticleFrame_RestoreTouchedCells)(benchmark::State& state) {
+    particleFrameBenchmark(state, win, false);
+}
+
+// Thread scaling: one update of a 100k-particle emitter split across 1..N threads (the caller
+// plus N - 1 pool workers; 1 = the single-threaded path)
+static void BM_ParticleUpdate_Threads(benchmark::State& state) {
+    using namespace stevensTerminal::ParticleFX;
+    size_t threads = static_cast<size_t>(state.range(1));
+    std::unique_ptr<stevensTerminal::ThreadPool> pool;
+    ParticleEffect effect(nullptr, 42);
+    if (threads > 1) {
+        pool = std::make_unique<stevensTerminal::ThreadPool>(threads - 1);
+        effect.setThreadPool(*pool);
+        effect.setParallelThreshold(0);
+    } else {
+        effect.setParallelThreshold(SIZE_MAX);
+    }
+    effect.spawnBurst(Vec2(40.0f, 12.0f), static_cast<int>(state.range(0)), ParticleBenchmarkData::prototype());
+    for (auto _ : state) {
+        effect.update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ParticleUpdate_Threads)->Apply([](benchmark::internal::Benchmark* b) {
+    int maxThreads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    for (int threads = 1; threads <= maxThreads; threads *= 2) b->Args({100000, threads});
+    if ((maxThreads & (maxThreads - 1)) != 0) b->Args({100000, maxThreads});
+})->UseRealTime();
+
+// Steady-state snow from a continuous emitter: one frame of spawn + update at ~Arg live particles
+static void BM_ParticleEmitter_Snow(benchmark::State& state) {
+    using namespace stevensTerminal::ParticleFX;
+    Particle flake = ParticleBenchmarkData::prototype();
+    flake.setPhysics(ParticlePresets::Snow());
+    flake.setLifetime(2.0f);
+    ParticleEffect effect(nullptr, 42);
+    ParticleEmitter snow = ParticleEmitter::rect(0, 0, 80, 1);
+    snow.setPrototype(flake);
+    snow.setRate(static_cast<float>(state.range(0)) / 2.0f);
+    snow.setDirection(std::numbers::pi_v<float> / 2, 0.4f);
+    effect.addEmitter(snow);
+    for (int frame = 0; frame < 180; ++frame) effect.update(1.0f / 60.0f); // reach steady state
+    for (auto _ : state) {
+        effect.update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+}
+BENCHMARK(BM_ParticleEmitter_Snow)->Arg(1000)->Arg(10000)->Arg(100000);
+
+// One render of Arg particles clustered in a 20x10 patch: a write per particle vs one per
+// covered cell with the particles merged into braille dots
+static void particleRenderBenchmark(benchmark::State& state, WINDOW* win,
+                                    stevensTerminal::ParticleFX::RenderMode mode) {
+    using namespace stevensTerminal::ParticleFX;
+    Particle spark = ParticleBenchmarkData::prototype();
+    spark.setModifyChar(true);
+    spark.setCharacter('*');
+    spark.setLifetime(10.0f);
+    ParticleEffect effect(win, 42);
+    effect.setRenderMode(mode);
+    ParticleEmitter patch = ParticleEmitter::rect(30, 7, 20, 10);
+    patch.setPrototype(spark);
+    patch.setRate(static_cast<float>(state.range(0)));
+    patch.setSpeedRange(0.0f, 0.0f);
+    effect.addEmitter(patch);
+    effect.update(1.0f);
+    for (auto _ : state) {
+        effect.render();
+    }
+    state.counters["cells"] = static_cast<double>(effect.getCellsWritten());
+}
+
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_ParticleRender_Cell)(benchmark::State& state) {
+    particleRenderBenchmark(state, win, stevensTerminal::ParticleFX::RenderMode::Cell);
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_ParticleRender_Cell)->Arg(1000)->Arg(10000);
+
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_ParticleRender_Braille)(benchmark::State& state) {
+    particleRenderBenchmark(state, win, stevensTerminal::ParticleFX::RenderMode::Braille);
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_ParticleRender_Braille)->Arg(1000)->Arg(10000);
+
+// One frame (update + render) of Arg falling particles leaving a 4-step fading trail
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_ParticleTrail_Frame)(benchmark::State& state) {
+    using namespace stevensTerminal::ParticleFX;
+    Particle flake = ParticleBenchmarkData::prototype();
+    flake.setPhysics(ParticlePresets::Snow());
+    flake.setModifyBg(false);
+    flake.setLifetime(2.0f);
+    ParticleEffect effect(win, 42);
+    effect.setTrail({{'.', 0}, {':', 0}, {'*', 0}, {'#', 0}}, 0.2f, 0.5f);
+    ParticleEmitter snow = ParticleEmitter::rect(0, 0, 80, 1);
+    snow.setPrototype(flake);
+    snow.setRate(static_cast<float>(state.range(0)) / 2.0f);
+    snow.setDirection(std::numbers::pi_v<float> / 2, 0.4f);
+    effect.addEmitter(snow);
+    for (int frame = 0; frame < 120; ++frame) effect.update(1.0f / 60.0f);
+    for (auto _ : state) {
+        effect.update(1.0f / 60.0f);
+        effect.render();
+    }
+    state.counters["cells"] = static_cast<double>(effect.getCellsWritten());
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_ParticleTrail_Frame)->Arg(1000)->Arg(10000);
+
+// One update of 10k falling particles over a window of text, without (0) and with (1)
+// collisions against the text's occupancy bitmap
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_ParticleUpdate_ContentCollision)(benchmark::State& state) {
+    using namespace stevensTerminal::ParticleFX;
+    for (int y = 4; y < 24; y += 4) mvwprintw(win, y, 0, "%s", std::string(60, 'a' + y).c_str());
+    ParticleWindowRegistry::registerWindow(win);
+    Particle flake = ParticleBenchmarkData::prototype();
+    flake.setPhysics(ParticlePresets::Snow());
+    ParticleEffect effect(win, 42);
+    effect.setContentCollision(state.range(0) != 0);
+    effect.setParallelThreshold(SIZE_MAX);
+    effect.spawnRain(0, 79, 10000, flake);
+    for (auto _ : state) {
+        effect.update(1.0f / 60.0f);
+        benchmark::ClobberMemory();
+    }
+    ParticleWindowRegistry::unregisterWindow(win);
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_ParticleUpdate_ContentCollision)->Arg(0)->Arg(1);
+
+// A party screen's worth of bars per frame (Arg bars on 20 rows x 4 columns of 18-wide bars,
+// one bar in ten changing each frame): printBar() for every bar vs a compiled BarRenderer
+static std::vector<stevensTerminal::BarValue> partyBarValues(size_t count, int frame) {
+    std::vector<stevensTerminal::BarValue> values(count);
+    for (size_t i = 0; i < count; ++i) {
+        int drift = (i % 10 == static_cast<size_t>(frame % 10)) ? frame : 0;
+        values[i] = {static_cast<int>((i * 37 + drift) % 101), 100};
+    }
+    return values;
+}
+
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_Bars_PrintBar)(benchmark::State& state) {
+    stevensTerminal::BarSpec spec;
+    spec.width = 18;
+    size_t count = static_cast<size_t>(state.range(0));
+    int frame = 0;
+    for (auto _ : state) {
+        std::vector<stevensTerminal::BarValue> values = partyBarValues(count, frame++);
+        for (size_t i = 0; i < count; ++i) {
+            stevensTerminal::printBar(win, static_cast<int>(i % 20), static_cast<int>(i / 20) * 20,
+                                      values[i].current, values[i].total, spec);
+        }
+    }
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_Bars_PrintBar)->Arg(80);
+
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_Bars_BarRenderer)(benchmark::State& state) {
+    stevensTerminal::BarSpec spec;
+    spec.width = 18;
+    stevensTerminal::BarRenderer bars(spec);
+    size_t count = static_cast<size_t>(state.range(0));
+    int frame = 0;
+    for (auto _ : state) {
+        std::vector<stevensTerminal::BarValue> values = partyBarValues(count, frame++);
+        for (size_t column = 0; column * 20 < count; ++column) {
+            size_t first = column * 20;
+            std::span<const stevensTerminal::BarValue> span(values.data() + first, std::min<size_t>(20, count - first));
+            bars.drawColumn(win, 0, static_cast<int>(column) * 20, span);
+        }
+    }
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_Bars_BarRenderer)->Arg(80);
+
+// Redrawing 20 stacked bar series per frame, two of them with changed data each frame
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_Chart_StackedSeries)(benchmark::State& state) {
+    std::vector<stevensTerminal::StackedBarChart> charts;
+    std::vector<std::vector<float>> data;
+    for (int row = 0; row < 20; ++row) {
+        charts.emplace_back(std::vector<std::string>{"Cult", "Town", "Crown", "Wild"},
+                            std::vector<std::tuple<std::string, std::string>>{
+                                {"red", "white"}, {"blue", "white"}, {"green", "black"}, {"yellow", "black"}},
+                            76);
+        data.push_back({1.0f + row, 2.0f, 3.0f, 4.0f});
+    }
+    int frame = 0;
+    for (auto _ : state) {
+        data[frame % 20][0] += 0.5f;
+        data[(frame + 7) % 20][3] += 0.5f;
+        ++frame;
+        for (int row = 0; row < 20; ++row) charts[row].draw(win, row, 2, data[row]);
+    }
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_Chart_StackedSeries);
+
+// One frame of a 40x3 frame-time sparkline: push a sample and redraw. Flat across history sizes.
+BENCHMARK_DEFINE_F(HeadlessNcursesFixture, BM_Sparkline_PushAndDraw)(benchmark::State& state) {
+    stevensTerminal::Sparkline line(static_cast<size_t>(state.range(0)), 40, 3);
+    float sample = 0.0f;
+    for (int64_t i = 0; i < state.range(0); ++i) line.push(16.0f + std::sin(sample += 0.1f));
+    for (auto _ : state) {
+        line.push(16.0f + std::sin(sample += 0.1f));
+        line.draw(win, 0, 0);
+    }
+}
+BENCHMARK_REGISTER_F(HeadlessNcursesFixture, BM_Sparkline_PushAndDraw)->Arg(3600)->Arg(1 << 20);
+
+// One 16ms frame of servicing N periodic timers (spinners and pulses) plus a tween per 16 timers
+static void BM_TimerWheel_ServiceFrame(benchmark::State& state) {
+    stevensTerminal::TimerWheel timers;
+    uint64_t sink = 0;
+    for (int64_t i = 0; i < state.range(0); ++i) {
+        timers.every(50 + static_cast<uint64_t>(i % 7) * 20, [&sink](uint64_t period) { sink += period; });
+        if (i % 16 == 0) {
+            timers.tween(1000, stevensTerminal::easing::inOutSine, [&sink](float t) { sink += t > 0.5f; },
+                         stevensTerminal::TimerWheel::Repeat::PingPong);
+        }
+    }
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(timers.advance(16));
+    }
+    benchmark::DoNotOptimize(sink);
+}
+BENCHMARK(BM_TimerWheel_ServiceFrame)->Arg(12)->Arg(1000);
+
+// One frame of fading a full 80x24 window and pushing it to the terminal:
+// 0 = AnimatedPalette via init_color (xterm-256color), 1 = its Rewrite fallback (xterm),
+// 2 = redrawing every cell with the new colour pair, as before palette animation
+static void BM_Palette_FadeFrame(benchmark::State& state) {
+    const int approach = static_cast<int>(state.range(0));
+    FILE* devnull = fopen("/dev/null", "w");
+    SCREEN* screen = newterm(approach == 0 ? "xterm-256color" : "xterm", devnull, stdin);
+    set_term(screen);
+    start_color();
+    stevensTerminal::Colors::curses_setup_colorCodes();
+    stevensTerminal::Colors::curses_setup_colorPairs();
+    WINDOW* win = newwin(24, 80, 0, 0);
+    const std::string row(80, '#');
+    const stevensTerminal::Rgb ramp[] = {{255, 0, 0}, {255, 255, 0}, {0, 255, 0}, {0, 0, 255}};
+    {
+        stevensTerminal::AnimatedPalette palette(1, approach == 0 ? stevensTerminal::AnimatedPalette::Mode::Palette
+                                                                  : stevensTerminal::AnimatedPalette::Mode::Rewrite);
+        int slot = palette.reserve(ramp[0]);
+        palette.use(win, slot);
+        for (int y = 0; y < 24; ++y) mvwaddnstr(win, y, 0, row.c_str(), 80);
+        palette.bind(slot, win, 0, 0, 24, 80);
+        wnoutrefresh(win);
+        doupdate();
+
+        size_t frame = 0;
+        for (auto _ : state) {
+            const stevensTerminal::Rgb color = ramp[++frame % 4];
+            if (approach == 2) {
+                wcolor_set(win, static_cast<short>(stevensTerminal::Colors::lookupColorPairByName(
+                    frame % 2 ? "yellow" : "red", "black")), nullptr);
+                for (int y = 0; y < 24; ++y) mvwaddnstr(win, y, 0, row.c_str(), 80);
+            } else {
+                palette.set(slot, color);
+            }
+            wnoutrefresh(win);
+            doupdate();
+        }
+    }
+    delwin(win);
+    stevensTerminal::Colors::curses_colorPairs.clear();
+    stevensTerminal::Colors::curses_colors.clear();
+    endwin();
+    delscreen(screen);
+    fclose(devnull);
+}
+BENCHMARK(BM_Palette_FadeFrame)->Arg(0)->Arg(1)->Arg(2);
+
 BENCHMARK_MAIN();
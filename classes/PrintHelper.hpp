@@ -1082,46 +1082,117 @@ namespace PrintHelper
 	}
 
 
-	//TODO: Needs to be tested for multiple tokens, Needs to print individual lines at a time to account for fitting inside of borders
 	/**
-	 * Prints text with style tokens to a curses window.
-	 * 
+	 * One piece of text placed by the layout step of curses_wprint().
+	 *
+	 * Members:
+	 * 	std::string text - What to print: a whole token, or one wrapped row of a token or string.
+	 * 	int y - The row to print at.
+	 * 	int x - The column to print at.
+	 * 	bool atCursor - True if the run continues wherever the previous run left the cursor instead of starting at (y, x).
+	 * 					Unwrapped tokens do this, since the printer (not the layout) decides where overlong text wraps.
+	 * 	int token - Index of the run's token in PrintLayout::tokens, or -1 if the run uses the layout's base style.
+	 * 	size_t source - Byte offset of the run's text in the string that was laid out, once locatePrintRuns() has found it.
+	 * 					std::string::npos if it hasn't (or the text isn't one contiguous piece of that string).
+	*/
+	struct PrintRun
+	{
+		std::string text;
+		int y = 0;
+		int x = 0;
+		bool atCursor = false;
+		int token = -1;
+		size_t source = std::string::npos;
+	};
+
+
+	/**
+	 * Where and how curses_wprint() places its text, worked out without touching a window. The curses printer
+	 * (curses_wprintLayout()) and off-screen rasterizers (FramePipeline's CellRaster) both print from this, so the
+	 * two always agree on the layout.
+	 *
+	 * Members:
+	 * 	std::vector<PrintToken> tokens - The tokens the runs were cut from, for their styles.
+	 * 	std::unordered_map<std::string,std::string> style - The style for runs whose token is not styled itself.
+	 * 	bool styled - False if text styling was off, in which case no run is styled at all.
+	 * 	std::vector<PrintRun> runs - The runs to print, in order.
+	*/
+	struct PrintLayout
+	{
+		std::vector<PrintToken> tokens;
+		std::unordered_map<std::string,std::string> style;
+		bool styled = false;
+		std::vector<PrintRun> runs;
+	};
+
+
+	/**
+	 * Lays out a plain string wrapped to the width of a window, one run per row (the layout of curses_wwrap()).
+	 *
 	 * Parameters:
-	 * 	WINDOW * win - The curses window we are printing to.
-	 * 	int yMove - How far down to move within the curses window before we begin printing.
-	 * 	int xMove - How far right to move within the curses window before we begin printing.
-	 * 	std::string printString - The string we will be printing to the curses window.
-	 * 	std::vector<PrintToken> tokens - An ordered collection of PrintToken objects which will be printed to the curses window.
-	 * 	std::unordered_map<std::string,std::string> style - Styling options for all unstyled tokens.
-	 * 	unordereD_map<std::string,std::string> format - Advanced formatting options for printing.
-	 * 													Valid key-value pairs are:
-	 * 													{"avoid borders","true"/"false"}
-	 * 														-Avoid reprinting over 
-	 * 
+	 * 	int winWidth - The width of the window being printed to.
+	 * 	int yMove - The row to begin printing at.
+	 * 	int xMove - The column every row begins at.
+	 * 	const std::string & printString - The string to wrap.
+	 * 	size_t indent - The amount of spaces to print at the start of every row.
+	 * 	std::vector<PrintRun> & runs - Where the rows are appended.
+	 *
 	 * Returns:
 	 * 	void
 	*/
-	inline void curses_wprint_withTokens(	WINDOW * win,
-									int yMove,
-									int xMove,
-									std::vector<PrintToken> tokens,
-									std::unordered_map<std::string,std::string> style,
-									std::unordered_map<std::string,std::string> format,
-									bool textStyling	)
+	inline void layoutWrappedString(	int winWidth,
+										int yMove,
+										int xMove,
+										const std::string & printString,
+										size_t indent,
+										std::vector<PrintRun> & runs	)
 	{
-		//Holds data for which attributes to use before printing text
-		std::unordered_map<std::string, chtype> curses_attribute_data = {};
-		//Process the style map's attributes
-		std::unordered_map<std::string, chtype> style_attribute_data = curses_styleAttributes(style);
+		// Characters available for text, accounting for where we start (xMove) and the indent
+		// reserved on every printed row. If the window is too narrow to fit anything, fall back
+		// to printing unwrapped rather than looping - matches the previous behavior for this
+		// degenerate case.
+		int textWidth = winWidth - xMove - (int)indent;
+		std::string wrapped = (textWidth > 0)
+			? stevensStringLib::wrapToWidth(printString, static_cast<size_t>(textWidth))
+			: printString;
 
-		/*** Formatting ***/
-		//Very important - get the window size
-		int winHeight;
-		int winWidth;
-		getmaxyx(win, winHeight, winWidth);
-		//Where the lines will start and end
-		int lineStart = 0;
-		int lineEnd = winWidth + 1;
+		std::istringstream in(wrapped);
+		std::string line;
+		while(getline(in,line))
+		{
+			PrintRun run;
+			run.text = std::string(indent, ' ') + line;
+			run.y = yMove++;
+			run.x = xMove;
+			runs.push_back(std::move(run));
+		}
+	}
+
+
+	/**
+	 * Lays out tokens one after another without wrapping them (the layout of curses_wprint_withTokens()). The first
+	 * token is placed at (yMove, xMove) and every token after it continues from the cursor.
+	 *
+	 * Parameters:
+	 * 	int winHeight - The height of the window being printed to.
+	 * 	int winWidth - The width of the window being printed to.
+	 * 	int yMove - The row to begin printing at.
+	 * 	int xMove - The column to begin printing at.
+	 * 	const std::vector<PrintToken> & tokens - The tokens to lay out.
+	 * 	std::unordered_map<std::string,std::string> format - Advanced formatting options, see curses_wprint_withTokens().
+	 * 	std::vector<PrintRun> & runs - Where the tokens are appended.
+	 *
+	 * Returns:
+	 * 	void
+	*/
+	inline void layoutTokens(	int winHeight,
+								int winWidth,
+								int yMove,
+								int xMove,
+								const std::vector<PrintToken> & tokens,
+								std::unordered_map<std::string,std::string> format,
+								std::vector<PrintRun> & runs	)
+	{
 		//If we are avoiding window borders while printing, we make sure are starting our printing within the window size
 		if(format.contains("avoid borders"))
 		{
@@ -1147,37 +1218,279 @@ namespace PrintHelper
 				{
 					yMove = winHeight - 1;
 				}
+			}
+		}
 
-				//Window width and height modifier for borders
-				winWidth -= 2;
-				winHeight -= 2;
-				//Make the lines start and end within the border of the window
-				lineStart = 1;
-				lineEnd = winWidth;
+		for(size_t i = 0; i < tokens.size(); i++)
+		{
+			PrintRun run;
+			run.text = tokens[i].content;
+			run.y = yMove;
+			run.x = xMove;
+			// Advance position so the next token continues from where this one ended
+			run.atCursor = (i > 0);
+			run.token = tokens[i].styled ? static_cast<int>(i) : -1;
+			runs.push_back(std::move(run));
+		}
+	}
+
+
+	/**
+	 * Lays out tokens wrapped to the width of a window, one run per row of each token (the layout of
+	 * curses_wwrap_withTokens()).
+	 *
+	 * Parameters:
+	 * 	int winWidth - The width of the window being printed to.
+	 * 	int yMove - The row to begin printing at.
+	 * 	int xMove - The column to begin printing at.
+	 * 	const std::vector<PrintToken> & tokens - The tokens to lay out.
+	 * 	std::unordered_map<std::string,std::string> format - Advanced formatting options, see curses_wwrap_withTokens().
+	 * 	std::vector<PrintRun> & runs - Where the rows are appended.
+	 *
+	 * Returns:
+	 * 	void
+	*/
+	inline void layoutWrappedTokens(	int winWidth,
+										int yMove,
+										int xMove,
+										const std::vector<PrintToken> & tokens,
+										std::unordered_map<std::string,std::string> format,
+										std::vector<PrintRun> & runs	)
+	{
+		//Set the xMove origin
+		int xMoveOrigin = xMove;
+		bool retainXMoveOnNewline = false;
+		//retain xmove on newline - whenever a newline is input, start printing after the newline at xMoveOrigin
+		if(format.contains("retain xmove on newline"))
+		{
+			if(stevensStringLib::stringToBool(format["retain xmove on newline"]))
+			{
+				retainXMoveOnNewline = true;
+			}
+		}
+		//Border adjustment
+		bool avoidBorders = false;
+		int borderAdjustment = 0;
+		if(format.contains("avoid borders"))
+		{
+			//If we are set to avoid borders while printing, check that here
+			if(stevensStringLib::stringToBool(format["avoid borders"]))
+			{
+				borderAdjustment = 1;
+				avoidBorders = true;
 			}
 		}
 
-		//For each token we are printing:
-		for(int i = 0; i < tokens.size(); i++)
+		// Text alignment within the available line width.
+		// "left" (default) prints from xMove; "center" offsets each segment so it is
+		// horizontally centred; "right" is reserved for future use.
+		std::string textAlign = format.contains("textAlign") ? format.at("textAlign") : "left";
+
+		// The x position every row resets to after a wrap or an explicit newline - as opposed to
+		// the first row of a token, which may continue mid-row from wherever the previous token
+		// (or, for the very first token, whatever was already printed before this function was
+		// called) left off. xMove itself always holds "where the next row starts" - updated
+		// after every printed row below - so it's used directly, with no separate tracking needed.
+		int resetXMove = retainXMoveOnNewline ? xMoveOrigin : (avoidBorders ? 1 : 0);
+
+		//For each token we are laying out:
+		for(size_t i = 0; i < tokens.size(); i++)
 		{
-			//Is the token specifically styled?
-			if(tokens[i].styled)
+			// Wrap this token's content by display width, preferring to break at spaces (see
+			// stevensStringLib::wrapToWidth()). This token's first row may have a reduced budget
+			// if it's continuing mid-row from the previous token (or from before this call);
+			// every row after that - whether from a wrap or an explicit newline in the token's
+			// own content - gets the full reset-position width.
+			int constantWidth = (winWidth - borderAdjustment) - resetXMove;
+			int firstSegmentWidth = (winWidth - borderAdjustment) - xMove;
+			std::string wrapped = (constantWidth > 0)
+				? stevensStringLib::wrapToWidth(
+					tokens[i].content,
+					static_cast<size_t>(std::max(constantWidth, 0)),
+					static_cast<size_t>(std::max(firstSegmentWidth, 0)))
+				: tokens[i].content;
+
+			//Split into the individual rows this token will occupy
+			std::vector<std::string> rows;
 			{
-				curses_attribute_data = curses_styleToken(tokens[i]);
+				std::istringstream in(wrapped);
+				std::string rowLine;
+				while(getline(in, rowLine))
+				{
+					rows.push_back(rowLine);
+				}
+			}
+
+			//Place each row of the token
+			for(size_t r = 0; r < rows.size(); r++)
+			{
+				int rowWidth = static_cast<int>(stevensStringLib::lineDisplayWidth(rows[r]));
+				int availableWidth = (winWidth - borderAdjustment) - xMove;
+				int printX = xMove + (textAlign == "center"
+					? std::max(0, (availableWidth - rowWidth) / 2)
+					: 0);
+
+				PrintRun run;
+				run.text = std::move(rows[r]);
+				run.y = yMove;
+				run.x = printX;
+				run.token = tokens[i].styled ? static_cast<int>(i) : -1;
+				runs.push_back(std::move(run));
+
+				//Where printing left the cursor, in case the next row/token continues here
+				xMove = printX + rowWidth;
+
+				//Advance to a fresh row only if more rows remain within THIS token (a wrap or an
+				//explicit newline in its own content) - if this was the token's last row, leave
+				//xMove where printing ended so the next token (if any) continues on the same row.
+				if((r + 1) < rows.size())
+				{
+					yMove++;
+					xMove = resetXMove;
+				}
+			}
+		}
+	}
+
+
+	/**
+	 * The layout step of curses_wprint(): tokenizes the input and places its text, without printing anything.
+	 *
+	 * Parameters:
+	 * 	int winHeight - The height of the window (or cell buffer) being printed to.
+	 * 	int winWidth - The width of the window (or cell buffer) being printed to.
+	 * 	int yMove, int xMove, std::string input, style, format, bool textStyling - Same as curses_wprint().
+	 *
+	 * Returns:
+	 * 	PrintLayout - The runs to print and the styles they use.
+	*/
+	inline PrintLayout layoutPrint(	int winHeight,
+									int winWidth,
+									int yMove,
+									int xMove,
+									std::string input,
+									std::unordered_map<std::string,std::string> style,
+									std::unordered_map<std::string,std::string> format,
+									bool textStyling	)
+	{
+		PrintLayout layout;
+		//Tokenize what we're going to be printing, just to see if a user included any inline style tokens
+		std::vector<PrintToken> tokens = tokenizePrintString(input);
+		bool wrap = format.contains("wrap") && stevensStringLib::stringToBool(format["wrap"]);
+
+		//If we are not styling text, we skip applying the styles. We just remove the curly and square brackets around the tokens
+		if(!textStyling)
+		{
+			std::string printString = ignoreTokenStyling(input, tokens);
+			if(wrap)
+			{
+				layoutWrappedString(winWidth, yMove, xMove, printString, 0, layout.runs);
 			}
-			//Are there any styles to apply to all of the non-specifically styled tokens?
 			else
 			{
-				curses_attribute_data = style_attribute_data;
+				PrintRun run;
+				run.text = std::move(printString);
+				run.y = yMove;
+				run.x = xMove;
+				layout.runs.push_back(std::move(run));
+			}
+			return layout;
+		}
+
+		//For any space in between tokens, we tokenize that with default styling
+		layout.tokens = tokenizeBetweenTokens(input, tokens);
+		//Check to see if the style map is complete before we print
+		layout.style = PrintTokenStyling::setMissingStylesToDefault(style);
+		layout.styled = true;
+
+		if(wrap)
+		{
+			layoutWrappedTokens(winWidth, yMove, xMove, layout.tokens, format, layout.runs);
+		}
+		else
+		{
+			layoutTokens(winHeight, winWidth, yMove, xMove, layout.tokens, format, layout.runs);
+		}
+		return layout;
+	}
+
+
+	/**
+	 * Finds where each run of a layout came from in the string that was laid out, filling in PrintRun::source. Runs are
+	 * pieces of the input in order (token content and wrapped rows of it, with the style markup left out), so each one is
+	 * looked for after the end of the one before. Needed only to map byte offsets of the input onto the screen, e.g. to
+	 * highlight search matches.
+	 *
+	 * Parameters:
+	 * 	std::string_view input - The string that was passed to layoutPrint().
+	 * 	PrintLayout & layout - Its layout.
+	 *
+	 * Returns:
+	 * 	void
+	*/
+	inline void locatePrintRuns(	std::string_view input,
+									PrintLayout & layout	)
+	{
+		size_t cursor = 0;
+		for(PrintRun & run : layout.runs)
+		{
+			size_t found = run.text.empty() ? std::string_view::npos : input.find(run.text, cursor);
+			run.source = found;
+			if(found != std::string_view::npos)
+			{
+				cursor = found + run.text.size();
+			}
+		}
+	}
+
+
+	/**
+	 * Prints a laid out string to a curses window, styling each run.
+	 *
+	 * Parameters:
+	 * 	WINDOW * win - The curses window we are printing to.
+	 * 	const PrintLayout & layout - The layout to print, see layoutPrint().
+	 *
+	 * Returns:
+	 * 	void
+	*/
+	inline void curses_wprintLayout(	WINDOW * win,
+										const PrintLayout & layout	)
+	{
+		//Holds data for which attributes to use before printing text
+		std::unordered_map<std::string, chtype> curses_attribute_data = {};
+		//Process the style map's attributes
+		std::unordered_map<std::string, chtype> style_attribute_data;
+		if(layout.styled)
+		{
+			style_attribute_data = curses_styleAttributes(layout.style);
+		}
+
+		//Consecutive runs of one token (its wrapped rows) share its attributes
+		int attributesToken = -2;
+		for(const PrintRun & run : layout.runs)
+		{
+			if(layout.styled && run.token != attributesToken)
+			{
+				//Is the run's token specifically styled? If not, use the style for all unstyled tokens
+				curses_attribute_data = (run.token >= 0)
+					? curses_styleToken(layout.tokens[run.token])
+					: style_attribute_data;
+				attributesToken = run.token;
 			}
 
 			//Turn on the attributes specified in our styles
 			curses_wAttrOn(win, curses_attribute_data);
 
 			//Print!
-			mvwprintw(win, yMove, xMove, "%s", tokens[i].content.c_str());
-			// Advance position so the next token continues from where this one ended
-			getyx(win, yMove, xMove);
+			if(run.atCursor)
+			{
+				wprintw(win, "%s", run.text.c_str());
+			}
+			else
+			{
+				mvwprintw(win, run.y, run.x, "%s", run.text.c_str());
+			}
 
 			//Turn off all attributes
 			curses_wAttrOff(win, curses_attribute_data);
@@ -1185,6 +1498,47 @@ namespace PrintHelper
 	}
 
 
+	//TODO: Needs to be tested for multiple tokens, Needs to print individual lines at a time to account for fitting inside of borders
+	/**
+	 * Prints text with style tokens to a curses window.
+	 * 
+	 * Parameters:
+	 * 	WINDOW * win - The curses window we are printing to.
+	 * 	int yMove - How far down to move within the curses window before we begin printing.
+	 * 	int xMove - How far right to move within the curses window before we begin printing.
+	 * 	std::string printString - The string we will be printing to the curses window.
+	 * 	std::vector<PrintToken> tokens - An ordered collection of PrintToken objects which will be printed to the curses window.
+	 * 	std::unordered_map<std::string,std::string> style - Styling options for all unstyled tokens.
+	 * 	unordereD_map<std::string,std::string> format - Advanced formatting options for printing.
+	 * 													Valid key-value pairs are:
+	 * 													{"avoid borders","true"/"false"}
+	 * 														-Avoid reprinting over 
+	 * 
+	 * Returns:
+	 * 	void
+	*/
+	inline void curses_wprint_withTokens(	WINDOW * win,
+									int yMove,
+									int xMove,
+									std::vector<PrintToken> tokens,
+									std::unordered_map<std::string,std::string> style,
+									std::unordered_map<std::string,std::string> format,
+									bool textStyling	)
+	{
+		//Very important - get the window size
+		int winHeight;
+		int winWidth;
+		getmaxyx(win, winHeight, winWidth);
+
+		PrintLayout layout;
+		layout.tokens = std::move(tokens);
+		layout.style = std::move(style);
+		layout.styled = true;
+		layoutTokens(winHeight, winWidth, yMove, xMove, layout.tokens, format, layout.runs);
+		curses_wprintLayout(win, layout);
+	}
+
+
 	/**
 	 * Prints a string to a curses window with advanced formatting options.
 	 * 
@@ -1211,73 +1565,23 @@ namespace PrintHelper
 						std::unordered_map<std::string,std::string> format,
 						bool textStyling	)
 	{
-		//Tokenize what we're going to be printing, just to see if a user included any inline style tokens
-		std::vector<PrintToken> tokens = tokenizePrintString(input);
-
-		//Check to see if we're doing text styling
-		if(textStyling)
-		{
-			//For any space in between tokens, we tokenize that with default styling
-			tokens = tokenizeBetweenTokens(input, tokens);
-
-			//Check to see if the style map is complete before we print
-			style = PrintTokenStyling::setMissingStylesToDefault(style);
+		int winHeight;
+		int winWidth;
+		getmaxyx(win, winHeight, winWidth);
 
-			//TODO
-			//Were there any style tokens in the input? If not, just print regularly with style
-			//This should speed up printing of borders
+		//TODO
+		//Were there any style tokens in the input? If not, just print regularly with style
+		//This should speed up printing of borders
+		curses_wprintLayout(win, layoutPrint(winHeight, winWidth, yMove, xMove, std::move(input), std::move(style), format, textStyling));
 
-			//Are we wrapping the text within the window?
-			if(format.contains("wrap"))
-			{
-				if(stevensStringLib::stringToBool(format["wrap"]))
-				{
-					curses_wwrap_withTokens(	win,
-												yMove,
-												xMove,
-												tokens,
-												style,
-												format,
-												textStyling	);
-					if(format.contains("debug"))
-					{					
-						std::cout << "finished print" << std::endl;
-						getch();
-					}
-					return;
-				}
-			}
-			//Print the tokens to the window
-			curses_wprint_withTokens(	win,
-										yMove,
-										xMove,
-										tokens,
-										style,
-										format,
-										textStyling	);
-		}
-		else
+		if(textStyling && format.contains("wrap") && format.contains("debug"))
 		{
-			//If we are not, then we skip applying the styles. We just remove the curly and square brackets around the tokens
-			std::string printString = ignoreTokenStyling(input, tokens);
-
-			if(format.contains("wrap"))
+			if(stevensStringLib::stringToBool(format["wrap"]))
 			{
-				if(stevensStringLib::stringToBool(format["wrap"]))
-				{
-					curses_wwrap( 	win,
-									yMove,
-									xMove,
-									printString,
-									0	);
-					return;
-				}
+				std::cout << "finished print" << std::endl;
+				getch();
 			}
-
-			//Print string to the screen
-			mvwprintw(win, yMove, xMove, "%s", printString.c_str());
 		}
-		return;
 	}
 
 
@@ -1301,51 +1605,17 @@ namespace PrintHelper
 						size_t indent,
 						std::unordered_map<std::string,std::string> style )
 	{
-		int width;
-		int height;
-		getmaxyx(win, height, width); //Curses function to get the width of the window we are printing to
+		int width = getmaxx(win); //Curses function to get the width of the window we are printing to
 
-		//Turn on any styles we might be using
-		std::unordered_map<std::string,chtype> curses_style_data;
+		PrintLayout layout;
+		//An empty style prints with whatever attributes the window already has on
 		if(!style.empty())
 		{
-			//Turn on the style attributes
-			curses_style_data = curses_styleAttributes(style);
-			curses_wAttrOn(win, curses_style_data);
-		}
-
-		// Characters available for text, accounting for where we start (xMove) and the indent
-		// reserved on every printed row. If the window is too narrow to fit anything, fall back
-		// to printing unwrapped rather than looping - matches the previous behavior for this
-		// degenerate case.
-		int textWidth = width - xMove - (int)indent;
-		std::string wrapped = (textWidth > 0)
-			? stevensStringLib::wrapToWidth(printString, static_cast<size_t>(textWidth))
-			: printString;
-
-		std::istringstream in(wrapped);
-		std::string line;
-		int numberOfLines = stevensStringLib::countLines(wrapped);
-		int currLineNum = 0;
-
-		while(getline(in,line))
-		{
-			std::string output = std::string(indent, ' ') + line;
-			mvwprintw(win, yMove, xMove, "%s", output.c_str());
-			currLineNum++;
-			//Move to the next row unless this was the last one
-			if(currLineNum < numberOfLines)
-			{
-				yMove++;
-				wmove(win, yMove, xMove);
-			}
-		}
-
-		//Turn off any styles we may have turned on for this function
-		if(!style.empty())
-		{
-			curses_wAttrOff(win, curses_style_data);
+			layout.style = std::move(style);
+			layout.styled = true;
 		}
+		layoutWrappedString(width, yMove, xMove, printString, indent, layout.runs);
+		curses_wprintLayout(win, layout);
 	}
 
 
@@ -1366,120 +1636,15 @@ namespace PrintHelper
 									std::unordered_map<std::string,std::string> format,
 									bool textStyling	)
 	{
-		//Holds data for which attributes to use before printing text
-		std::unordered_map<std::string, chtype> curses_attribute_data = {};
-		//Process the style map's attributes and store them in a map that can be understood by curses
-		std::unordered_map<std::string, chtype> style_attribute_data = curses_styleAttributes(style);
-
 		//Get the window size that we're printing to
-		int width;
-		int height;
-		getmaxyx(win, height, width); //Curses function to get the width of the window we are printing to
-		//Set the yMove and xMove origins
-		int yMoveOrigin = yMove;
-		int xMoveOrigin = xMove;
-		bool retainXMoveOnNewline = false;
-		//retain xmove on newline - whenever a newline is input, start printing after the newline at xMoveOrigin
-		if(format.contains("retain xmove on newline"))
-		{
-			if(stevensStringLib::stringToBool(format["retain xmove on newline"]))
-			{
-				retainXMoveOnNewline = true;
-			}
-		}
-		//Border adjustment
-		bool avoidBorders = false;
-		int borderAdjustment = 0;
-		if(format.contains("avoid borders"))
-		{
-			//If we are set to avoid borders while printing, check that here
-			if(stevensStringLib::stringToBool(format["avoid borders"]))
-			{
-				borderAdjustment = 1;
-				avoidBorders = true;
-			}
-		}
-
-		// Text alignment within the available line width.
-		// "left" (default) prints from xMove; "center" offsets each segment so it is
-		// horizontally centred; "right" is reserved for future use.
-		std::string textAlign = format.contains("textAlign") ? format.at("textAlign") : "left";
-
-		// The x position every row resets to after a wrap or an explicit newline - as opposed to
-		// the first row of a token, which may continue mid-row from wherever the previous token
-		// (or, for the very first token, whatever was already printed before this function was
-		// called) left off. xMove itself always holds "where the next row starts" - updated
-		// after every printed row below - so it's used directly, with no separate tracking needed.
-		int resetXMove = retainXMoveOnNewline ? xMoveOrigin : (avoidBorders ? 1 : 0);
-
-		//For each token we are printing:
-		for(int i = 0; i < tokens.size(); i++)
-		{
-			//Is the token specifically styled?
-			if(tokens[i].styled)
-			{
-				curses_attribute_data = curses_styleToken(tokens[i]);
-			}
-			//Are there any styles to apply to all of the non-specifically styled tokens?
-			else
-			{
-				curses_attribute_data = style_attribute_data;
-			}
-
-			PrintHelper::curses_wAttrOn(win, curses_attribute_data);
-
-			// Wrap this token's content by display width, preferring to break at spaces (see
-			// stevensStringLib::wrapToWidth()). This token's first row may have a reduced budget
-			// if it's continuing mid-row from the previous token (or from before this call);
-			// every row after that - whether from a wrap or an explicit newline in the token's
-			// own content - gets the full reset-position width.
-			int constantWidth = (width - borderAdjustment) - resetXMove;
-			int firstSegmentWidth = (width - borderAdjustment) - xMove;
-			std::string wrapped = (constantWidth > 0)
-				? stevensStringLib::wrapToWidth(
-					tokens[i].content,
-					static_cast<size_t>(std::max(constantWidth, 0)),
-					static_cast<size_t>(std::max(firstSegmentWidth, 0)))
-				: tokens[i].content;
-
-			//Split into the individual rows this token will occupy
-			std::vector<std::string> rows;
-			{
-				std::istringstream in(wrapped);
-				std::string rowLine;
-				while(getline(in, rowLine))
-				{
-					rows.push_back(rowLine);
-				}
-			}
-
-			//Print each row of the token
-			for(size_t r = 0; r < rows.size(); r++)
-			{
-				int rowXMove = xMove;
-				int availableWidth = (width - borderAdjustment) - rowXMove;
-				int printX = rowXMove + (textAlign == "center"
-					? std::max(0, (availableWidth - (int)stevensStringLib::lineDisplayWidth(rows[r])) / 2)
-					: 0);
-				mvwprintw(win, yMove, printX, "%s", rows[r].c_str());
-
-				//Where printing left the cursor, in case the next row/token continues here
-				xMove = printX + static_cast<int>(stevensStringLib::lineDisplayWidth(rows[r]));
-
-				//Advance to a fresh row only if more rows remain within THIS token (a wrap or an
-				//explicit newline in its own content) - if this was the token's last row, leave
-				//xMove where printing ended so the next token (if any) continues on the same row.
-				bool moreRowsThisToken = (r + 1) < rows.size();
-				if(moreRowsThisToken)
-				{
-					yMove++;
-					xMove = resetXMove;
-					wmove(win, yMove, xMove);
-				}
-			}
-
-			curses_wAttrOff(win, curses_attribute_data);
-		}
+		int width = getmaxx(win); //Curses function to get the width of the window we are printing to
+
+		PrintLayout layout;
+		layout.tokens = std::move(tokens);
+		layout.style = std::move(style);
+		layout.styled = true;
+		layoutWrappedTokens(width, yMove, xMove, layout.tokens, format, layout.runs);
+		curses_wprintLayout(win, layout);
 	}
 
 } // namespace PrintHelper
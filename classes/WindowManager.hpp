@@ -1,17 +1,31 @@
 /**
  * @brief Window Manager for efficient ncurses window handling
- * 
+ *
  * This class manages a set of reusable windows that can be dynamically
  * resized and repositioned for different views, eliminating the need
  * for constant window creation/destruction that causes flickering.
- * 
+ *
+ * Windows are stored in a flat vector and addressed by WindowId handles.
+ * Resolve a name to its WindowId once (initialize() / getWindowId()) and
+ * use the id in per-frame code; the string-keyed API is kept for setup
+ * code and backward compatibility, but hashes the name on every call.
+ *
+ * refreshAll() composites the windows in z-order and only stages the ones
+ * that changed since the last frame (plus whatever they overlap above them),
+ * skipping any window that is completely hidden behind windows over it.
+ * Which windows are hidden is only worked out again when a window's
+ * geometry or the z-order changes.
+ *
  * Part of the stevensTerminal library.
  */
 
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
 #include <unordered_map>
 #include <string>
+#include <utility>
 #include <vector>
 
 #if defined(__linux__)
@@ -30,9 +44,47 @@ namespace stevensTerminal {
         int width;
         int startY;
         int startX;
-        
-        WindowSpec(int h = 0, int w = 0, int y = 0, int x = 0) 
+
+        WindowSpec(int h = 0, int w = 0, int y = 0, int x = 0)
             : height(h), width(w), startY(y), startX(x) {}
+
+        bool operator==(const WindowSpec& other) const = default;
+    };
+
+    /**
+     * @brief Handle to a window owned by a WindowManager
+     *
+     * A plain index into the manager's window table - copying and comparing
+     * one is free, and looking a window up by id is a bounds-checked vector
+     * access. Ids stay valid until WindowManager::cleanup()/shutdown().
+     */
+    struct WindowId {
+        static constexpr uint32_t INVALID = UINT32_MAX;
+
+        uint32_t index = INVALID;
+
+        constexpr WindowId() = default;
+        constexpr explicit WindowId(uint32_t i) : index(i) {}
+
+        constexpr bool valid() const { return index != INVALID; }
+        constexpr bool operator==(const WindowId& other) const = default;
+    };
+
+    /**
+     * @brief Per-window state kept by the WindowManager alongside the WINDOW*
+     *
+     * spec   — geometry last applied by configureWindow()
+     * dirty  — the window must be staged by the next refreshAll() even if curses has no
+     *          pending changes for it (new geometry, z-order change, uncovered area).
+     *          Anything printed into the window is picked up via is_wintouched() anyway.
+     * zOrder — stacking order; higher values are drawn over lower ones
+     */
+    struct ManagedWindow {
+        std::string name;
+        WINDOW*     window = nullptr;
+        WindowSpec  spec   = WindowSpec(1, 1, 0, 0);
+        bool        dirty  = true;
+        int         zOrder = 0;
     };
 
     /**
@@ -40,118 +92,422 @@ namespace stevensTerminal {
      */
     class WindowManager {
     private:
-        std::unordered_map<std::string, WINDOW*> windows;
-        
+        std::vector<ManagedWindow> windows;
+        std::vector<std::string> names;                    // parallel to windows, for getWindowNames()
+        std::unordered_map<std::string, WindowId> idsByName;
+
+        std::vector<uint32_t> stackingOrder;  // window indices, lowest z first
+        bool stackingOrderStale = true;
+        size_t lastStagedCount = 0;
+
+        struct Rect {
+            int top, left, bottom, right;     // half-open: [top, bottom) x [left, right)
+
+            bool operator==(const Rect& other) const = default;
+        };
+
+        // refreshAll() state, parallel to stackingOrder and kept between frames so a frame
+        // allocates nothing. hidden is only recomputed when occlusionStale is set or a
+        // window's rect changed.
+        std::vector<Rect> rects;
+        std::vector<bool> hidden;
+        std::vector<bool> forced;
+        bool occlusionStale = true;
+
+        // Scratch space for isCovered()
+        std::vector<Rect> above;
+        std::vector<std::pair<int,int>> spans;
+
+        static Rect rectOf(WINDOW* win) {
+            int y, x, h, w;
+            getbegyx(win, y, x);
+            getmaxyx(win, h, w);
+            return Rect{y, x, y + h, x + w};
+        }
+
+        static bool overlaps(const Rect& a, const Rect& b) {
+            return a.left < b.right && b.left < a.right && a.top < b.bottom && b.top < a.bottom;
+        }
+
+        void sortStackingOrder() {
+            stackingOrder.resize(windows.size());
+            for (uint32_t i = 0; i < windows.size(); i++) {
+                stackingOrder[i] = i;
+            }
+            std::stable_sort(stackingOrder.begin(), stackingOrder.end(), [this](uint32_t a, uint32_t b) {
+                return windows[a].zOrder < windows[b].zOrder;
+            });
+            stackingOrderStale = false;
+            occlusionStale = true;
+        }
+
+        /**
+         * @brief Whether `target` is completely covered by the union of the rects in `above`
+         *
+         * The x-intervals of the covering windows are merged and checked against the
+         * target's span, once for every row where a covering window starts or ends -
+         * coverage can't change between those rows. Curses windows are opaque - staging
+         * one writes every one of its cells - so covered means invisible.
+         */
+        bool isCovered(const Rect& target) {
+            if (above.empty()) {
+                return false;
+            }
+            auto rowCovered = [&](int row) {
+                spans.clear();
+                for (const Rect& r : above) {
+                    if (r.top <= row && row < r.bottom && r.left < target.right && target.left < r.right) {
+                        spans.emplace_back(r.left, r.right);
+                    }
+                }
+                std::sort(spans.begin(), spans.end());
+                int reach = target.left;
+                for (const auto& [left, right] : spans) {
+                    if (left > reach) {
+                        break;
+                    }
+                    reach = std::max(reach, right);
+                }
+                return reach >= target.right;
+            };
+            if (!rowCovered(target.top)) {
+                return false;
+            }
+            for (const Rect& r : above) {
+                for (int row : {r.top, r.bottom}) {
+                    if (target.top < row && row < target.bottom && !rowCovered(row)) {
+                        return false;
+                    }
+                }
+            }
+            return true;
+        }
+
+        /**
+         * @brief Refresh the cached rects and, if any moved or the z-order changed, which windows are hidden
+         *
+         * Rects are re-read from curses every frame, so windows moved or resized directly
+         * through their WINDOW* are noticed too.
+         */
+        void updateOcclusion() {
+            const size_t n = stackingOrder.size();
+            if (rects.size() != n) {
+                rects.resize(n);
+                occlusionStale = true;
+            }
+            for (size_t i = 0; i < n; i++) {
+                Rect rect = rectOf(windows[stackingOrder[i]].window);
+                if (!(rect == rects[i])) {
+                    rects[i] = rect;
+                    occlusionStale = true;
+                }
+            }
+            if (!occlusionStale) {
+                return;
+            }
+
+            // Top down: each window is checked against everything above it
+            hidden.assign(n, false);
+            above.clear();
+            for (size_t i = n; i-- > 0; ) {
+                hidden[i] = isCovered(rects[i]);
+                above.push_back(rects[i]);
+            }
+            occlusionStale = false;
+        }
+
+        /**
+         * @brief Windows below `index` that overlap `area` need restaging to repaint it
+         */
+        void exposeBelow(uint32_t index, const Rect& area) {
+            for (uint32_t i = 0; i < windows.size(); i++) {
+                if (i != index && windows[i].zOrder <= windows[index].zOrder && overlaps(rectOf(windows[i].window), area)) {
+                    windows[i].dirty = true;
+                }
+            }
+        }
+
     public:
         WindowManager() = default;
-        
+
         ~WindowManager() {
             cleanup();
         }
-        
+
+        WindowManager(const WindowManager&) = delete;
+        WindowManager& operator=(const WindowManager&) = delete;
+
         /**
          * @brief Initialize the window manager with client-specified window names
          * @param windowNames Vector of window names to create
+         * @return The id of each window, in the same order as windowNames
          */
-        void initialize(const std::vector<std::string>& windowNames) {
+        std::vector<WindowId> initialize(const std::vector<std::string>& windowNames) {
+            std::vector<WindowId> ids;
+            ids.reserve(windowNames.size());
             for (const std::string& name : windowNames) {
                 // Create minimal windows - will be resized as needed
-                windows[name] = newwin(1, 1, 0, 0);
+                ids.push_back(getWindowId(name));
             }
+            return ids;
         }
-        
+
         /**
          * @brief Initialize with default window set (for backward compatibility)
          */
-        void initialize() {
-            initialize({"header", "art", "prompt", "responses", "debug"});
+        std::vector<WindowId> initialize() {
+            return initialize({"header", "art", "prompt", "responses", "debug"});
+        }
+
+        /**
+         * @brief Resolve a window name to its id, creating the window if it doesn't exist
+         *
+         * New windows are stacked above every existing one (z-order = creation order).
+         */
+        WindowId getWindowId(const std::string& name) {
+            auto it = idsByName.find(name);
+            if (it != idsByName.end()) {
+                return it->second;
+            }
+            WindowId id(static_cast<uint32_t>(windows.size()));
+            ManagedWindow managed;
+            managed.name = name;
+            managed.window = newwin(1, 1, 0, 0);
+            managed.zOrder = static_cast<int>(id.index);
+            windows.push_back(std::move(managed));
+            names.push_back(name);
+            idsByName.emplace(name, id);
+            stackingOrderStale = true;
+            return id;
+        }
+
+        /**
+         * @brief Look up a window's id without creating it
+         * @return An invalid WindowId if no window has that name
+         */
+        WindowId findWindowId(const std::string& name) const {
+            auto it = idsByName.find(name);
+            return it == idsByName.end() ? WindowId() : it->second;
         }
-        
+
         /**
          * @brief Get a window, creating it if it doesn't exist
          */
         WINDOW* getWindow(const std::string& name) {
-            auto it = windows.find(name);
-            if (it == windows.end()) {
-                windows[name] = newwin(1, 1, 0, 0);
-                return windows[name];
-            }
-            return it->second;
+            return windows[getWindowId(name).index].window;
         }
-        
+
+        /**
+         * @brief Get a window by id
+         * @return nullptr if the id is invalid or stale
+         */
+        WINDOW* getWindow(WindowId id) const {
+            return id.index < windows.size() ? windows[id.index].window : nullptr;
+        }
+
         /**
          * @brief Resize and reposition a window efficiently
          */
-        void configureWindow(const std::string& name, const WindowSpec& spec) {
-            WINDOW* win = getWindow(name);
-            
+        void configureWindow(WindowId id, const WindowSpec& spec) {
+            if (id.index >= windows.size()) {
+                return;
+            }
+            ManagedWindow& managed = windows[id.index];
+
+            // Whatever was under the window's old area has to be repainted if it moved or shrank
+            Rect before = rectOf(managed.window);
+
             // Resize and move the window
-            wresize(win, spec.height, spec.width);
-            mvwin(win, spec.startY, spec.startX);
-            
+            wresize(managed.window, spec.height, spec.width);
+            mvwin(managed.window, spec.startY, spec.startX);
+
+            Rect after = rectOf(managed.window);
+            if (before.top != after.top || before.left != after.left ||
+                before.bottom != after.bottom || before.right != after.right) {
+                exposeBelow(id.index, before);
+            }
+
             // Clear the window for fresh content
-            werase(win);
+            werase(managed.window);
+
+            managed.spec = spec;
+            managed.dirty = true;
+        }
+
+        void configureWindow(const std::string& name, const WindowSpec& spec) {
+            configureWindow(getWindowId(name), spec);
         }
-        
+
         /**
          * @brief Configure multiple windows at once for a specific view layout
          */
+        void configureLayout(const std::vector<std::pair<WindowId, WindowSpec>>& layout) {
+            for (const auto& [id, spec] : layout) {
+                configureWindow(id, spec);
+            }
+        }
+
         void configureLayout(const std::unordered_map<std::string, WindowSpec>& layout) {
             for (const auto& [name, spec] : layout) {
                 configureWindow(name, spec);
             }
         }
-        
+
         /**
          * @brief Get window by name (operator overload)
          */
         WINDOW* operator[](const std::string& name) {
             return getWindow(name);
         }
-        
+
+        WINDOW* operator[](WindowId id) const {
+            return getWindow(id);
+        }
+
         /**
          * @brief Check if a window exists
          */
         bool hasWindow(const std::string& name) const {
-            return windows.find(name) != windows.end();
+            return idsByName.find(name) != idsByName.end();
         }
-        
+
+        bool hasWindow(WindowId id) const {
+            return id.index < windows.size();
+        }
+
+        /**
+         * @brief Number of managed windows; valid ids are 0 .. windowCount() - 1
+         */
+        size_t windowCount() const {
+            return windows.size();
+        }
+
         /**
-         * @brief Get list of all window names
+         * @brief A window's name, geometry, dirty flag and z-order
+         *
+         * The id must be valid.
          */
-        std::vector<std::string> getWindowNames() const {
-            std::vector<std::string> names;
-            for (const auto& [name, window] : windows) {
-                names.push_back(name);
+        const ManagedWindow& info(WindowId id) const {
+            return windows[id.index];
+        }
+
+        /**
+         * @brief Set a window's stacking order (higher is drawn on top)
+         */
+        void setZOrder(WindowId id, int zOrder) {
+            if (id.index < windows.size() && windows[id.index].zOrder != zOrder) {
+                windows[id.index].zOrder = zOrder;
+                windows[id.index].dirty = true;
+                exposeBelow(id.index, rectOf(windows[id.index].window));
+                stackingOrderStale = true;
+            }
+        }
+
+        /**
+         * @brief Flag a window as having changes that refreshAll() must stage
+         *
+         * Not needed after printing into the window - curses' own change tracking
+         * (is_wintouched()) already covers that.
+         */
+        void markDirty(WindowId id) {
+            if (id.index < windows.size()) {
+                windows[id.index].dirty = true;
             }
+        }
+
+        /**
+         * @brief Whether the next refreshAll() will stage this window (unless it is hidden)
+         */
+        bool isDirty(WindowId id) const {
+            return id.index < windows.size() &&
+                   (windows[id.index].dirty || is_wintouched(windows[id.index].window));
+        }
+
+        /**
+         * @brief Number of windows the last refreshAll() actually staged
+         */
+        size_t stagedWindowCount() const {
+            return lastStagedCount;
+        }
+
+        /**
+         * @brief Get list of all window names, indexed by WindowId
+         */
+        const std::vector<std::string>& getWindowNames() const {
             return names;
         }
-        
+
         /**
          * @brief Clean up all windows
+         *
+         * Every WindowId handed out so far becomes invalid.
          */
         void cleanup() {
-            for (auto& [name, window] : windows) {
-                if (window != nullptr) {
-                    delwin(window);
+            for (ManagedWindow& managed : windows) {
+                if (managed.window != nullptr) {
+                    delwin(managed.window);
                 }
             }
             windows.clear();
+            names.clear();
+            idsByName.clear();
+            stackingOrder.clear();
+            stackingOrderStale = true;
+            rects.clear();
+            occlusionStale = true;
         }
-        
+
         /**
          * @brief Refresh all windows efficiently using double buffering
+         *
+         * Windows are staged bottom to top in z-order, so overlaps always resolve the
+         * same way. Only dirty windows are staged, plus any window above a staged one
+         * that overlaps it (otherwise the lower window would paint over it). A window
+         * entirely hidden behind the windows above it is skipped and stays dirty until
+         * it is uncovered.
          */
         void refreshAll() {
-            for (const auto& [name, window] : windows) {
-                wnoutrefresh(window);
+            if (stackingOrderStale) {
+                sortStackingOrder();
+            }
+
+            updateOcclusion();
+
+            const size_t n = stackingOrder.size();
+            forced.assign(n, false);
+            lastStagedCount = 0;
+            for (size_t i = 0; i < n; i++) {
+                ManagedWindow& managed = windows[stackingOrder[i]];
+                if (hidden[i]) {
+                    continue;
+                }
+                bool stage = managed.dirty || is_wintouched(managed.window);
+                if (forced[i]) {
+                    touchwin(managed.window); // restage all of it, not just its own changes
+                    stage = true;
+                }
+                if (!stage) {
+                    continue;
+                }
+                if (managed.dirty) {
+                    touchwin(managed.window);
+                }
+                wnoutrefresh(managed.window);
+                managed.dirty = false;
+                lastStagedCount++;
+
+                for (size_t j = i + 1; j < n; j++) {
+                    if (!forced[j] && overlaps(rects[i], rects[j])) {
+                        forced[j] = true;
+                    }
+                }
             }
             doupdate(); // Single screen update
         }
-        
+
         /**
          * @brief Complete shutdown of window manager and ncurses
-         * 
+         *
          * This is the recommended way to clean up when terminating a program
          * that uses stevensTerminal. It handles proper cleanup order:
          * 1. Clean up all managed windows
@@ -163,4 +519,4 @@ namespace stevensTerminal {
         }
     };
 
-} // namespace stevensTerminal
\ No newline at end of file
+} // namespace stevensTerminal
@@ -9,7 +9,11 @@
 #if defined(__linux__)
 #include <sys/ioctl.h>
 #include <unistd.h>
+#include <fcntl.h>
+#include <csignal>
+#include <cerrno>
 #endif
+#include <atomic>
 #include <limits>
 #include <fstream>
 
@@ -20,6 +24,7 @@
 #include "subnamespaces/Colors.hpp"
 #include "subnamespaces/Input.hpp"
 #include "subnamespaces/ParticleFX/ParticleWindowRegistry.hpp"
+#include "subnamespaces/Resize.hpp"
 #include "subnamespaces/Styling.hpp"
 
 namespace stevensTerminal
@@ -44,21 +49,48 @@ WindowManager& windowManager() {
     return instance;
 }
 
+// Screen size cached by the resize watch (see Resize.hpp), packed as width << 32 | height so
+// readers on any thread see a consistent pair. Only trusted while screenSizeCached is set; the
+// SIGWINCH handler clears it, so between a signal and the settled resize, callers query again.
+static std::atomic<uint64_t> cachedScreenSize{0};
+static std::atomic<bool> screenSizeCached{false};
+
 #if defined(_WIN32)
-std::pair<int, int> get_screen_size() {
+static std::pair<int, int> queryScreenSize() {
     CONSOLE_SCREEN_BUFFER_INFO csbi;
     GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
     return std::pair<int, int>(csbi.srWindow.Right - csbi.srWindow.Left + 1,
                                csbi.srWindow.Bottom - csbi.srWindow.Top + 1);
 }
 #elif defined(__linux__)
-std::pair<int, int> get_screen_size() {
-    struct winsize size;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &size);
+static std::pair<int, int> queryScreenSize() {
+    struct winsize size = {};
+    if (ioctl(STDOUT_FILENO, TIOCGWINSZ, &size) != 0 || size.ws_col == 0 || size.ws_row == 0) {
+        // stdout isn't a terminal (redirected, or a test harness) - fall back to what curses
+        // thinks the screen is, or the classic 80x24
+        if (stdscr != nullptr && COLS > 0 && LINES > 0) {
+            return std::pair<int, int>(COLS, LINES);
+        }
+        return std::pair<int, int>(80, 24);
+    }
     return std::pair<int, int>(size.ws_col, size.ws_row);
 }
 #endif
 
+static void cacheScreenSize(std::pair<int, int> size) {
+    cachedScreenSize.store((static_cast<uint64_t>(static_cast<uint32_t>(size.first)) << 32) |
+                           static_cast<uint32_t>(size.second), std::memory_order_relaxed);
+    screenSizeCached.store(true, std::memory_order_release);
+}
+
+std::pair<int, int> get_screen_size() {
+    if (screenSizeCached.load(std::memory_order_acquire)) {
+        uint64_t packed = cachedScreenSize.load(std::memory_order_relaxed);
+        return std::pair<int, int>(static_cast<int>(packed >> 32), static_cast<int>(packed & 0xFFFFFFFFu));
+    }
+    return queryScreenSize();
+}
+
 void hideCursor() { curs_set(0); }
 
 void showCursor()
@@ -188,16 +220,174 @@ bool displayMode_LTEmaxSize(std::pair<int,int> maxSize, std::pair<int,int> scree
     return (screenSize.first <= maxSize.first && screenSize.second <= maxSize.second);
 }
 
-void setDisplayMode(std::pair<int,int> screenSize) {
+std::string displayModeFor(std::pair<int,int> screenSize) {
     for(auto const& mode : displayModes) {
         if(displayMode_GTEminSize(mode.second.minSize, screenSize) &&
            displayMode_LTEmaxSize(mode.second.maxSize, screenSize)) {
-            currentDisplayMode = mode.first;
-            return;
+            return mode.first;
         }
     }
     // If no mode matches, default to "regular"
-    currentDisplayMode = "regular";
+    return "regular";
+}
+
+void setDisplayMode(std::pair<int,int> screenSize) {
+    currentDisplayMode = displayModeFor(screenSize);
+}
+
+// ==================== RESIZE.HPP IMPLEMENTATIONS ====================
+
+static ResizeCallback resizeCallback;
+static std::chrono::milliseconds resizeDebounce{50};
+static std::chrono::steady_clock::time_point lastResizeSignal;
+static std::pair<int, int> lastSettledSize{-1, -1};
+#if !defined(__linux__)
+static std::pair<int, int> lastObservedSize{-1, -1}; // console size at the last poll
+#endif
+static bool resizeWatching = false;
+static bool resizeSettling = false;
+
+#if defined(__linux__)
+static int resizePipe[2] = {-1, -1};
+static struct sigaction previousWinchAction;
+
+// Async-signal-safe: only write(), an atomic store, and the chained handler
+static void onSigwinch(int signal) {
+    int savedErrno = errno;
+    screenSizeCached.store(false, std::memory_order_relaxed);
+    if (resizePipe[1] >= 0) {
+        char byte = 1;
+        ssize_t ignored = write(resizePipe[1], &byte, 1); // a full pipe already means "resized"
+        (void)ignored;
+    }
+    if (!(previousWinchAction.sa_flags & SA_SIGINFO) &&
+        previousWinchAction.sa_handler != SIG_DFL && previousWinchAction.sa_handler != SIG_IGN) {
+        previousWinchAction.sa_handler(signal); // ncurses' own handler, which queues KEY_RESIZE
+    }
+    errno = savedErrno;
+}
+#endif
+
+// The size is still inside the current mode's bounds - no need to look for another mode
+static bool currentDisplayModeContains(std::pair<int, int> screenSize) {
+    auto mode = displayModes.find(currentDisplayMode);
+    return mode != displayModes.end() &&
+           displayMode_GTEminSize(mode->second.minSize, screenSize) &&
+           displayMode_LTEmaxSize(mode->second.maxSize, screenSize);
+}
+
+void startResizeWatch(ResizeCallback onResize, std::chrono::milliseconds debounce) {
+    stopResizeWatch();
+    resizeCallback = std::move(onResize);
+    resizeDebounce = debounce;
+    resizeSettling = false;
+
+    #if defined(__linux__)
+        if (pipe(resizePipe) != 0) {
+            resizePipe[0] = resizePipe[1] = -1;
+            std::cerr << "Error, could not create resize pipe; resizes will not be coalesced." << std::endl;
+            return;
+        }
+        for (int fd : resizePipe) {
+            fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+            fcntl(fd, F_SETFD, FD_CLOEXEC);
+        }
+        struct sigaction action = {};
+        action.sa_handler = onSigwinch;
+        sigemptyset(&action.sa_mask);
+        action.sa_flags = SA_RESTART;
+        sigaction(SIGWINCH, &action, &previousWinchAction);
+    #endif
+
+    lastSettledSize = queryScreenSize();
+    cacheScreenSize(lastSettledSize);
+    #if !defined(__linux__)
+        lastObservedSize = lastSettledSize;
+    #endif
+    resizeWatching = true;
+}
+
+void stopResizeWatch() {
+    if (!resizeWatching) {
+        return;
+    }
+    #if defined(__linux__)
+        sigaction(SIGWINCH, &previousWinchAction, nullptr);
+        for (int& fd : resizePipe) {
+            close(fd);
+            fd = -1;
+        }
+    #endif
+    screenSizeCached.store(false, std::memory_order_release);
+    resizeCallback = nullptr;
+    resizeWatching = false;
+    resizeSettling = false;
+}
+
+bool pollResize() {
+    if (!resizeWatching) {
+        return false;
+    }
+    auto now = std::chrono::steady_clock::now();
+
+    #if defined(__linux__)
+        char drain[64];
+        bool signalled = false;
+        while (read(resizePipe[0], drain, sizeof(drain)) > 0) {
+            signalled = true;
+        }
+    #else
+        // No SIGWINCH here - poll the console size and treat every change as a signal
+        std::pair<int, int> observed = queryScreenSize();
+        bool signalled = observed != lastObservedSize;
+        lastObservedSize = observed;
+    #endif
+    if (signalled) {
+        lastResizeSignal = now;
+        resizeSettling = true;
+    }
+    if (!resizeSettling || now - lastResizeSignal < resizeDebounce) {
+        return false;
+    }
+    resizeSettling = false;
+
+    std::pair<int, int> size = queryScreenSize();
+    cacheScreenSize(size);
+    if (size == lastSettledSize) {
+        return false; // dragged out and back again
+    }
+    lastSettledSize = size;
+
+    if (stdscr != nullptr && is_term_resized(size.second, size.first)) {
+        resizeterm(size.second, size.first);
+    }
+
+    ResizeEvent event;
+    event.width = size.first;
+    event.height = size.second;
+    if (!currentDisplayModeContains(size)) {
+        std::string mode = displayModeFor(size);
+        event.displayModeChanged = mode != currentDisplayMode;
+        currentDisplayMode = mode;
+    }
+    event.displayMode = currentDisplayMode;
+
+    if (resizeCallback) {
+        resizeCallback(event);
+    }
+    return true;
+}
+
+bool resizePending() {
+    return resizeSettling;
+}
+
+int resizeEventFd() {
+    #if defined(__linux__)
+        return resizeWatching ? resizePipe[0] : -1;
+    #else
+        return -1;
+    #endif
 }
 
 // ==================== COLORS.HPP IMPLEMENTATIONS ====================
@@ -655,15 +845,18 @@ namespace stevensTerminal
 			return result;
 		}
 
-		std::string percentageStr = std::to_string(stevensMathLib::roundToNearest10th(percentage * 100));
+		// One decimal place ("33.3"), not std::to_string's six
+		long tenths = std::lround(stevensMathLib::roundToNearest10th(percentage * 100) * 10);
+		std::string percentageStr = std::to_string(tenths / 10) + "." + std::to_string(tenths % 10);
 
 		// Try text + percentage first (most informative)
 		if (showText && showPercentage) {
 			std::string combined = labelText + " " + percentageStr + "%";
-			if (static_cast<int>(combined.length()) <= availableWidth) {
+			int combinedWidth = static_cast<int>(stevensStringLib::lineDisplayWidth(combined));
+			if (combinedWidth <= availableWidth) {
 				result.text = combined;
 				result.style = BarGraphLabelStyle::TextAndPercentage;
-				result.width = combined.length();
+				result.width = combinedWidth;
 				result.indent = (availableWidth - result.width) / 2;
 				return result;
 			}
@@ -682,10 +875,11 @@ namespace stevensTerminal
 		}
 
 		// Try text only
-		if (showText && static_cast<int>(labelText.length()) <= availableWidth) {
+		int labelWidth = showText ? static_cast<int>(stevensStringLib::lineDisplayWidth(labelText)) : 0;
+		if (showText && labelWidth <= availableWidth) {
 			result.text = labelText;
 			result.style = BarGraphLabelStyle::TextOnly;
-			result.width = labelText.length();
+			result.width = labelWidth;
 			result.indent = (availableWidth - result.width) / 2;
 			return result;
 		}
@@ -723,83 +917,20 @@ namespace stevensTerminal
 			return; // Styling must be enabled for colored graphs
 		}
 
-		// Calculate total distribution
-		float sumOfDistributions = 0;
-		for(size_t labelIndex = 0; labelIndex < labels.size(); labelIndex++)
-		{
-			sumOfDistributions += distribution[labelIndex];
-		}
-
-		// Guard against division by zero
-		if(sumOfDistributions == 0)
-		{
-			return; // Cannot create bar graph with zero total distribution
-		}
-
-		// Calculate percentages for each label
-		std::vector<float> distributionPercentages;
-		distributionPercentages.reserve(labels.size());
-		for(size_t labelIndex = 0; labelIndex < labels.size(); labelIndex++)
+		if(!stdscr)
 		{
-			distributionPercentages.push_back(distribution[labelIndex] / sumOfDistributions);
+			return; // Curses isn't running
 		}
 
-		// Calculate bar width for each segment (in characters)
-		std::vector<int> segmentWidths;
-		segmentWidths.reserve(labels.size());
-		for(size_t labelIndex = 0; labelIndex < labels.size(); labelIndex++)
+		// Zero-total distributions draw nothing; StackedBarChart reports them
+		int cursorY, cursorX;
+		getyx(stdscr, cursorY, cursorX);
+		StackedBarChart chart(std::move(labels), colorCombos, width, textLabels, percentageLabels);
+		if(!chart.draw(stdscr, cursorY, cursorX, distribution))
 		{
-			int segmentWidth = static_cast<int>(floor(distributionPercentages[labelIndex] * width));
-			segmentWidths.push_back(segmentWidth);
-		}
-
-		// Render each bar segment
-		for(size_t labelIndex = 0; labelIndex < labels.size(); labelIndex++)
-		{
-			// Calculate optimal label for this segment
-			BarGraphLabelFormat labelFormat = calculateBarGraphLabel(
-				labels[labelIndex],
-				distributionPercentages[labelIndex],
-				segmentWidths[labelIndex],
-				textLabels,
-				percentageLabels
-			);
-
-			// Get colors for this segment
-			const std::string& bgColor = std::get<0>(colorCombos[labelIndex]);
-			const std::string& textColor = std::get<1>(colorCombos[labelIndex]);
-
-			// Print the segment character by character
-			int charsRemaining = segmentWidths[labelIndex];
-			int indentRemaining = labelFormat.indent;
-			size_t labelCharIndex = 0;
-
-			while(charsRemaining > 0)
-			{
-				// // Print indent spaces first
-				// if(indentRemaining > 0)
-				// {
-				// 	print(" ", {{"textColor", textColor}, {"bgColor", bgColor}});
-				// 	indentRemaining--;
-				// }
-				// // Then print label characters
-				// else if(labelCharIndex < labelFormat.text.length())
-				// {
-				// 	std::string charAsString(1, labelFormat.text[labelCharIndex]);
-				// 	print(charAsString, {{"textColor", textColor}, {"bgColor", bgColor}, {"bold", "true"}});
-				// 	labelCharIndex++;
-				// }
-				// // Fill remaining space
-				// else
-				// {
-				// 	print(" ", {{"textColor", textColor}, {"bgColor", bgColor}});
-				// }
-
-				charsRemaining--;
-			}
+			return;
 		}
-
-		std::cout << "\n";
+		wmove(stdscr, std::min(cursorY + 1, getmaxy(stdscr) - 1), 0);
 	}
 
 // NOTE: table() (plain std::cout ANSI-styling-era table printer) was removed
@@ -1194,15 +1325,10 @@ namespace stevensTerminal
 							std::unordered_map<std::string,std::string> style,
 							std::unordered_map<std::string,std::string> format	)
 	{
-		//Create an input stream from the file we are trying to print
-		std::ifstream input_file(filePath);
-		if (!input_file.is_open())
-		{
-			//Error if we cannot successfully print the file
-			throw std::invalid_argument("Error, could not find file: " + filePath);
-		}
-		//Store the text content of the file in a string
-		std::string fileContent = std::string((std::istreambuf_iterator<char>(input_file)), std::istreambuf_iterator<char>());
+		//Map the file we are trying to print (throws std::invalid_argument if it can't be opened) and
+		//copy its text content into a string in one go, rather than char-by-char through a stream
+		MappedFile mappedFile(filePath);
+		std::string fileContent(mappedFile.view());
 
 		/*** Formatting ***/
 		//A lot of textfiles contain a last newline to indicate the end of the file. We can choose to remove that here.
@@ -1221,7 +1347,8 @@ namespace stevensTerminal
 
 		//COMMENTED OUT (We already do this in the wprint function below)
 		//If we are printing the file to a bordered window, check to see if we're avoiding printing on the border
-		int yMove, xMove = 0; 
+		int yMove = 0;
+		int xMove = 0;
 		if(format.contains("avoid borders"))
 		{
 			if(stevensStringLib::stringToBool(format["avoid borders"]))
@@ -19,8 +19,22 @@
 #include "subnamespaces/Input.hpp"
 #include "subnamespaces/ParticleFX/ParticleFX.hpp"
 #include "subnamespaces/Bar.hpp"
+#include "subnamespaces/BarRenderer.hpp"
+#include "subnamespaces/Chart.hpp"
+#include "subnamespaces/Sparkline.hpp"
 #include "subnamespaces/Spinner.hpp"
+#include "subnamespaces/Palette.hpp"
+#include "subnamespaces/TimerWheel.hpp"
+#include "subnamespaces/FrameScheduler.hpp"
 #include "subnamespaces/Animation.hpp"
+#include "subnamespaces/ScrollList.hpp"
+#include "subnamespaces/TextSearch.hpp"
+#include "subnamespaces/FileViewer.hpp"
+#include "subnamespaces/Layout.hpp"
+#include "subnamespaces/Resize.hpp"
+#include "subnamespaces/RenderQueue.hpp"
+#include "subnamespaces/ThreadPool.hpp"
+#include "subnamespaces/FramePipeline.hpp"
 
 namespace stevensTerminal
 {
@@ -40,41 +54,21 @@ namespace stevensTerminal
 	constexpr int DEFAULT_MENU_WIDTH = 18;  // Default width for menu items
 	constexpr int MIN_CELL_WIDTH = 8;       // Minimum width for grid cells
 
-	// Label style options for bar graphs
-	enum class BarGraphLabelStyle {
-		None,
-		TextOnly,
-		PercentageOnly,
-		TextAndPercentage
-	};
-
-	// Result of label formatting calculation
-	struct BarGraphLabelFormat {
-		std::string text;
-		BarGraphLabelStyle style;
-		int width;
-		int indent;
-	};
-
-	/************* Helper Functions *************/
+	// NOTE: BarGraphLabelStyle, BarGraphLabelFormat and calculateBarGraphLabel() moved to
+	// subnamespaces/Chart.hpp, alongside the chart widgets that use them.
 
+	/************* Methods *************/
 	/**
-	 * @brief Calculates the optimal label format based on available space
-	 * @param labelText The text label to display
-	 * @param percentage The percentage value (0.0 to 1.0)
-	 * @param availableWidth How much space is available in the bar
-	 * @param showText Whether text labels are enabled
-	 * @param showPercentage Whether percentage labels are enabled
-	 * @return Formatted label with calculated width and indent
+	 * @brief Draw a stacked horizontal bar graph on stdscr at the cursor, then move the cursor
+	 * to the start of the next line. See StackedBarChart for drawing into a window, and for
+	 * redrawing every frame without recomputing the layout.
+	 * @param labels           Segment labels
+	 * @param colorCombos      (background, text colour) names per segment
+	 * @param distribution     Segment sizes (any non-negative scale)
+	 * @param width            Bar width in cells
+	 * @param textLabels       Show segment labels
+	 * @param percentageLabels Show segment percentages
 	 */
-	inline BarGraphLabelFormat calculateBarGraphLabel(
-		const std::string& labelText,
-		float percentage,
-		int availableWidth,
-		bool showText,
-		bool showPercentage);
-
-	/************* Methods *************/
 	void horizontalStackedBarGraph(	std::vector<std::string> labels,
 									std::vector< std::tuple<std::string,std::string> > colorCombos,
 									std::vector<float> distribution,
@@ -492,6 +486,9 @@ namespace stevensTerminal
 	/**
 	 * Prints a vector to a window and location using the n/pd curses library.
 	 *
+	 * Every element is formatted on every call. For collections much longer than the window
+	 * (inventories, logs), use ScrollList instead, which only formats the visible slice.
+	 *
 	 * Parameters:
 	 * 	vector<T> vec - The vector we'd like to print a window of our curses app.
 	 * 	unordered_map<std::string,std::string> style -
@@ -682,6 +679,9 @@ namespace stevensTerminal
 		*
 		* 	Returns:
 		* 		void, but prints to the console using curses
+		*
+		*	The whole file is tokenized and wrapped on every call. For large files (logs), use
+		*	FileViewer instead, which maps the file and only formats the lines on screen.
 		*/
 	void curses_wprintFile(	WINDOW * win,
 							std::string filePath,
@@ -4,10 +4,11 @@
  * @brief General-purpose animation loop for stevensTerminal.
  */
 
-#include <atomic>
-#include <chrono>
+#include <algorithm>
+#include <cstdint>
 #include <functional>
-#include <thread>
+#include "FrameScheduler.hpp"
+#include "TimerWheel.hpp"
 
 namespace stevensTerminal
 {
@@ -20,42 +21,42 @@ namespace stevensTerminal
     /**
      * @brief Run an animation loop on the calling thread until keepRunning() returns false.
      *
-     * A background ticker thread increments a frame counter every opts.frameDuration milliseconds.
-     * onFrame(frame) is called on the calling thread every opts.renderMs milliseconds with
-     * the current frame number — use it to redraw whatever window(s) you like.
+     * The frame counter advances every opts.frameDuration milliseconds on a periodic timer in
+     * animationTimers(). onFrame(frame) is called every opts.renderMs milliseconds with the
+     * current frame number — use it to redraw whatever window(s) you like. Each render tick also
+     * services animationTimers(), so spinners and tweens registered there animate alongside.
      *
-     * All threading, atomics, and timing are handled internally; the caller only
-     * provides what to draw and when to stop.
+     * Everything runs on the calling thread; the caller only provides what to draw and when to stop.
      *
      * @param keepRunning  Returns true while the operation is still in progress.
      * @param onFrame      Called each render tick with the current frame index.
-     * @param opts         Timing options (tickMs, renderMs).
+     * @param opts         Timing options (frameDuration, renderMs).
      */
     inline void runAnimation(std::function<bool()>    keepRunning,
                              std::function<void(int)> onFrame,
                              AnimationOptions         opts = {})
     {
-        const int tickMs   = opts.frameDuration;
-        const int renderMs = opts.renderMs;
-        std::atomic<int>  frame  { 0 };
-        std::atomic<bool> running{ true };
-
-        std::thread ticker([&]() {
-            while (running.load(std::memory_order_relaxed))
-            {
-                frame.fetch_add(1, std::memory_order_relaxed);
-                std::this_thread::sleep_for(std::chrono::milliseconds(tickMs));
-            }
-        });
+        TimerWheel& timers = animationTimers();
+        int frame = 0;
+        struct Ticker
+        {
+            TimerWheel&    timers;
+            TimerWheel::Id id;
+            ~Ticker() { timers.cancel(id); }   // the timer refers to `frame`, so never outlive it
+        } ticker{ timers, timers.every(static_cast<uint64_t>(std::max(opts.frameDuration, 1)),
+                                       [&frame](uint64_t period) { frame = static_cast<int>(period); }) };
 
-        while (keepRunning())
+        // Render ticks are paced against absolute deadlines, so time spent in onFrame() is not
+        // added on top of renderMs
+        FrameScheduler renderTicks(1000.0 / std::max(opts.renderMs, 1));
+        while (true)
         {
-            onFrame(frame.load(std::memory_order_relaxed));
-            std::this_thread::sleep_for(std::chrono::milliseconds(renderMs));
+            renderTicks.beginFrame();
+            if (!keepRunning()) break;
+            timers.service();
+            onFrame(frame);
+            renderTicks.endFrame();
         }
-
-        running.store(false);
-        ticker.join();
     }
 
 } // namespace stevensTerminal
@@ -0,0 +1,238 @@
+#pragma once
+/**
+ * @file BarRenderer.hpp
+ * @brief Compiled bar renderer for screens that draw many bars every frame.
+ *
+ * printBar() resolves its colour pairs by name and builds its fill strings on every call. A
+ * BarRenderer does that work once, when the BarSpec is compiled: colour pairs become ready
+ * attributes and the fill/empty characters become pre-built runs, so drawing a bar is a few
+ * waddnstr() calls on prefixes of those runs with no allocation. It also remembers the
+ * quantized fill it last drew at each position and skips bars whose fill hasn't changed.
+ *
+ * Eighth-block precision draws the boundary cell with ▏▎▍▌▋▊▉, for 8x the resolution of
+ * whole cells.
+ *
+ * Usage:
+ *   stevensTerminal::BarRenderer hpBars({.width = 20, .fillBgColor = "red"});
+ *   // every frame:
+ *   hpBars.drawColumn(partyWin, 1, 12, hpValues);   // one bar per row, unchanged ones skipped
+ *   // after werase()/resizing the window:
+ *   hpBars.invalidate(partyWin);
+ */
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include "Bar.hpp"
+
+namespace stevensTerminal
+{
+    /**
+     * @brief One bar's value for BarRenderer::drawColumn()
+     */
+    struct BarValue
+    {
+        int current = 0;
+        int total   = 1;
+    };
+
+    class BarRenderer
+    {
+    public:
+        /**
+         * @brief Resolution of the boundary between the filled and empty parts.
+         *
+         * Cell   — whole cells only, like printBar() without a halfChar
+         * Half   — spec.halfChar (or ▌ if it's empty) when the boundary cell is at least half full
+         * Eighth — ▏▎▍▌▋▊▉ in the boundary cell
+         */
+        enum class Precision { Cell, Half, Eighth };
+
+        /**
+         * @brief Compile spec for drawing. Colours must already be initialized (start_color()
+         * and the library's colour pairs), since they're resolved here rather than per draw.
+         */
+        explicit BarRenderer(const BarSpec& spec = {}, Precision precision = Precision::Eighth)
+        {
+            compile(spec, precision);
+        }
+
+        /**
+         * @brief Recompile for a new spec. Every bar is redrawn on its next draw.
+         */
+        void compile(const BarSpec& spec, Precision precision = Precision::Eighth)
+        {
+            width = std::max(spec.width, 0);
+            steps = precision == Precision::Eighth ? 8 : (precision == Precision::Half ? 2 : 1);
+
+            const bool useBlockChars = (spec.fillChar != " " || spec.emptyChar != " ");
+            fillAttr  = COLOR_PAIR(Colors::lookupColorPairByName(spec.fillFgColor, spec.fillBgColor));
+            emptyAttr = COLOR_PAIR(Colors::lookupColorPairByName(spec.emptyFgColor, spec.emptyBgColor));
+            // The boundary glyph's ink is the fill colour: the fill's background for a colour-block
+            // bar, its foreground for a character bar. Either way it sits on the empty background.
+            const std::string& ink = useBlockChars ? spec.fillFgColor : spec.fillBgColor;
+            partialAttr = COLOR_PAIR(Colors::lookupColorPairByName(ink, spec.emptyBgColor));
+
+            fillRun  = repeat(spec.fillChar.empty() ? std::string(" ") : spec.fillChar, fillCellBytes);
+            emptyRun = repeat(spec.emptyChar.empty() ? std::string(" ") : spec.emptyChar, emptyCellBytes);
+            halfGlyph = spec.halfChar.empty() ? std::string(leftEighths[4]) : spec.halfChar;
+
+            // The percentage overlay only makes sense on a colour-block bar, as in printBar()
+            showPct = spec.showPct && !useBlockChars;
+            invalidate();
+        }
+
+        /**
+         * @brief Draw one bar at (y, x), unless the bar last drawn there had the same quantized
+         * fill (and percentage, if shown).
+         * @return True if the bar was drawn
+         */
+        bool draw(WINDOW* win, int y, int x, int current, int total)
+        {
+            if (!win || total <= 0) return false;
+
+            const int64_t clamped = std::clamp(current, 0, total);
+            const int units = static_cast<int>(clamped * width * steps / total);
+            const int pct = showPct ? static_cast<int>(clamped * 100 / total) : 0;
+
+            DrawnState& drawn = lastDrawn[Key{win, y, x}];
+            if (drawn.units == units && drawn.pct == pct) return false;
+            drawn.units = units;
+            drawn.pct = pct;
+
+            paint(win, y, x, units, pct);
+            return true;
+        }
+
+        /**
+         * @brief Draw bars on consecutive rows starting at (y, x), one per value
+         * @return Number of bars drawn (the rest were unchanged)
+         */
+        size_t drawColumn(WINDOW* win, int y, int x, std::span<const BarValue> values)
+        {
+            size_t drawn = 0;
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                drawn += draw(win, y + static_cast<int>(i), x, values[i].current, values[i].total);
+            }
+            return drawn;
+        }
+
+        /** @brief Forget what was drawn, so every bar is redrawn, e.g. after werase(). */
+        void invalidate() { lastDrawn.clear(); }
+
+        /** @brief Forget what was drawn in one window. */
+        void invalidate(WINDOW* win)
+        {
+            std::erase_if(lastDrawn, [win](const auto& entry) { return entry.first.win == win; });
+        }
+
+        int barWidth() const { return width; }
+
+    private:
+        // U+258F..U+2589: one to seven eighths, left-aligned
+        static constexpr std::string_view leftEighths[8] = {
+            "", "\xE2\x96\x8F", "\xE2\x96\x8E", "\xE2\x96\x8D",
+            "\xE2\x96\x8C", "\xE2\x96\x8B", "\xE2\x96\x8A", "\xE2\x96\x89"
+        };
+
+        struct Key
+        {
+            WINDOW* win;
+            int     y;
+            int     x;
+
+            bool operator==(const Key& other) const = default;
+        };
+
+        struct KeyHash
+        {
+            size_t operator()(const Key& key) const
+            {
+                size_t h = std::hash<const void*>()(key.win);
+                h ^= (static_cast<size_t>(key.y) * 0x9E3779B97F4A7C15ull) + (h << 6) + (h >> 2);
+                h ^= (static_cast<size_t>(key.x) * 0xC2B2AE3D27D4EB4Full) + (h << 6) + (h >> 2);
+                return h;
+            }
+        };
+
+        struct DrawnState
+        {
+            int units = -1;
+            int pct   = -1;
+        };
+
+        int         width = 0;
+        int         steps = 8;       // boundary positions per cell
+        bool        showPct = false;
+        attr_t      fillAttr = 0, emptyAttr = 0, partialAttr = 0;
+        std::string fillRun, emptyRun;       // the fill/empty character repeated `width` times
+        size_t      fillCellBytes = 1, emptyCellBytes = 1;
+        std::string halfGlyph;
+        std::unordered_map<Key, DrawnState, KeyHash> lastDrawn;
+
+        std::string repeat(const std::string& cell, size_t& cellBytes) const
+        {
+            cellBytes = cell.size();
+            std::string run;
+            run.reserve(cell.size() * width);
+            for (int i = 0; i < width; ++i) run += cell;
+            return run;
+        }
+
+        void paint(WINDOW* win, int y, int x, int units, int pct)
+        {
+            const int fullCells = units / steps;
+            const int remainder = units % steps;
+            // With Half precision the remainder is 1 exactly when the boundary cell is at least
+            // half full, as with printBar()'s halfChar
+            std::string_view boundary;
+            if (remainder > 0) boundary = steps == 8 ? leftEighths[remainder] : std::string_view(halfGlyph);
+            const int emptyStart = fullCells + (boundary.empty() ? 0 : 1);
+
+            wmove(win, y, x);
+            if (fullCells > 0)
+            {
+                wattron(win, fillAttr);
+                waddnstr(win, fillRun.data(), static_cast<int>(fullCells * fillCellBytes));
+                wattroff(win, fillAttr);
+            }
+            if (!boundary.empty())
+            {
+                wattron(win, partialAttr);
+                waddnstr(win, boundary.data(), static_cast<int>(boundary.size()));
+                wattroff(win, partialAttr);
+            }
+            if (emptyStart < width)
+            {
+                wattron(win, emptyAttr);
+                waddnstr(win, emptyRun.data(), static_cast<int>((width - emptyStart) * emptyCellBytes));
+                wattroff(win, emptyAttr);
+            }
+
+            if (showPct)
+            {
+                // Centred like printBar(); each digit takes the colour of the part it covers
+                char text[5];
+                int length = 0;
+                if (pct >= 100) text[length++] = '1';
+                if (pct >= 10) text[length++] = static_cast<char>('0' + (pct / 10) % 10);
+                text[length++] = static_cast<char>('0' + pct % 10);
+                text[length++] = '%';
+                const int start = (width - length) / 2;
+                for (int i = 0; i < length; ++i)
+                {
+                    const int column = start + i;
+                    if (column < 0 || column >= width) continue;
+                    mvwaddch(win, y, x + column, static_cast<chtype>(text[i]) | (column < fullCells ? fillAttr : emptyAttr));
+                }
+            }
+        }
+    };
+
+} // namespace stevensTerminal
@@ -0,0 +1,408 @@
+#pragma once
+/**
+ * @file Chart.hpp
+ * @brief Curses charts: stacked horizontal bars, vertical histograms and grouped bars.
+ *
+ * Each chart is set up once with its labels and colours, which are resolved to attributes
+ * then. Layouts are cached between frames: segment widths, fitted labels and bar heights are
+ * only recomputed when the data changes, and drawing writes from pre-built runs, so charts
+ * can be redrawn every frame without allocating.
+ *
+ * Usage:
+ *   stevensTerminal::StackedBarChart factions({"Cult", "Town", "Crown"},
+ *                                             {{"red", "white"}, {"blue", "white"}, {"yellow", "black"}}, 60);
+ *   factions.draw(statusWin, 2, 1, influence);          // influence: std::vector<float>
+ *
+ *   stevensTerminal::Histogram rolls(8, 2, 1, "green");
+ *   rolls.draw(statsWin, 0, 0, rollCounts);             // 8 rows tall, 2-wide bars, 1 gap
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+#include "Colors.hpp"
+#include "BarRenderer.hpp"
+
+namespace stevensTerminal
+{
+    // Label style options for bar graphs
+    enum class BarGraphLabelStyle {
+        None,
+        TextOnly,
+        PercentageOnly,
+        TextAndPercentage
+    };
+
+    // Result of label formatting calculation; width and indent are in display columns
+    struct BarGraphLabelFormat {
+        std::string text;
+        BarGraphLabelStyle style;
+        int width;
+        int indent;
+    };
+
+    /**
+     * @brief Calculates the optimal label format based on available space
+     * @param labelText The text label to display
+     * @param percentage The percentage value (0.0 to 1.0)
+     * @param availableWidth How much space is available in the bar
+     * @param showText Whether text labels are enabled
+     * @param showPercentage Whether percentage labels are enabled
+     * @return Formatted label with calculated width and indent
+     *
+     * Percentages have one decimal place ("Cult 33.3%", "100.0%"). They used to have
+     * std::to_string's six ("33.300000%"), which rarely fit inside a segment.
+     */
+    BarGraphLabelFormat calculateBarGraphLabel(
+        const std::string& labelText,
+        float percentage,
+        int availableWidth,
+        bool showText,
+        bool showPercentage);
+
+    /**
+     * @brief Split `width` cells between shares in proportion, with the largest-remainder method:
+     * every share gets the floor of its exact width, and the cells left over go to the shares
+     * with the largest fractional parts (earlier shares first on ties). The widths always add
+     * up to exactly `width`. All-zero shares give all-zero widths.
+     * @param widths Output, resized to shares.size()
+     * @param order  Scratch space, reused between calls
+     */
+    inline void largestRemainderSplit(std::span<const float> shares, int width,
+                                      std::vector<int>& widths, std::vector<size_t>& order)
+    {
+        widths.assign(shares.size(), 0);
+        float sum = 0.0f;
+        for (float share : shares) sum += std::max(share, 0.0f);
+        if (sum <= 0.0f || width <= 0) return;
+
+        int assigned = 0;
+        for (size_t i = 0; i < shares.size(); ++i)
+        {
+            widths[i] = static_cast<int>(std::max(shares[i], 0.0f) / sum * width);
+            assigned += widths[i];
+        }
+
+        order.resize(shares.size());
+        std::iota(order.begin(), order.end(), size_t{0});
+        auto remainder = [&](size_t i) { return std::max(shares[i], 0.0f) / sum * width - widths[i]; };
+        std::stable_sort(order.begin(), order.end(),
+                         [&](size_t a, size_t b) { return remainder(a) > remainder(b); });
+        for (size_t i = 0; assigned < width; i = (i + 1) % order.size(), ++assigned)
+        {
+            ++widths[order[i]];
+        }
+    }
+
+
+    /**
+     * @brief One horizontal bar split into coloured segments, each labelled with its text and/or
+     * percentage when the label fits (see calculateBarGraphLabel()).
+     */
+    class StackedBarChart
+    {
+    public:
+        /**
+         * @param labels          Segment labels
+         * @param colorCombos     (background, text colour) names per segment
+         * @param width           Bar width in cells
+         * @param textLabels      Show segment labels
+         * @param percentageLabels Show segment percentages
+         */
+        StackedBarChart(std::vector<std::string> labels,
+                        const std::vector<std::tuple<std::string,std::string>>& colorCombos,
+                        int width,
+                        bool textLabels = true,
+                        bool percentageLabels = true)
+            : labels(std::move(labels))
+            , width(std::max(width, 0))
+            , textLabels(textLabels)
+            , percentageLabels(percentageLabels)
+            , blanks(static_cast<size_t>(std::max(width, 0)), ' ')
+        {
+            for (size_t i = 0; i < colorCombos.size() && i < this->labels.size(); ++i)
+            {
+                attrs.push_back(COLOR_PAIR(Colors::lookupColorPairByName(std::get<1>(colorCombos[i]),
+                                                                         std::get<0>(colorCombos[i]))));
+            }
+            attrs.resize(this->labels.size(), A_NORMAL);
+        }
+
+        /**
+         * @brief Draw the bar at (y, x) for these segment sizes (any non-negative scale)
+         * @return False if distribution doesn't have one value per label or sums to zero
+         */
+        bool draw(WINDOW* win, int y, int x, std::span<const float> distribution)
+        {
+            if (!win || distribution.size() != labels.size()) return false;
+            if (!layoutValid || !std::equal(distribution.begin(), distribution.end(),
+                                            cachedDistribution.begin(), cachedDistribution.end()))
+            {
+                layout(distribution);
+            }
+            if (total <= 0.0f) return false;
+
+            wmove(win, y, x);
+            for (size_t i = 0; i < labels.size(); ++i)
+            {
+                const int segment = widths[i];
+                if (segment == 0) continue;
+                // A fitted label always fits its segment; widths are display columns, not bytes
+                const BarGraphLabelFormat& label = fitted[i];
+                const int trailing = segment - label.indent - label.width;
+
+                wattron(win, attrs[i]);
+                if (label.indent > 0) waddnstr(win, blanks.data(), label.indent);
+                if (label.width > 0)
+                {
+                    wattron(win, A_BOLD);
+                    waddnstr(win, label.text.data(), static_cast<int>(label.text.size()));
+                    wattroff(win, A_BOLD);
+                }
+                if (trailing > 0) waddnstr(win, blanks.data(), trailing);
+                wattroff(win, attrs[i]);
+            }
+            return true;
+        }
+
+        /** @brief Segment widths from the last draw(); they always add up to the bar width. */
+        const std::vector<int>& segmentWidths() const { return widths; }
+
+        /** @brief Recompute the layout on the next draw(), e.g. after changing colours. */
+        void invalidate() { layoutValid = false; }
+
+    private:
+        std::vector<std::string>         labels;
+        std::vector<attr_t>              attrs;
+        int                              width;
+        bool                             textLabels;
+        bool                             percentageLabels;
+        std::string                      blanks;     // `width` spaces, drawn as prefixes
+
+        // Cached layout
+        bool                             layoutValid = false;
+        std::vector<float>               cachedDistribution;
+        float                            total = 0.0f;
+        std::vector<int>                 widths;
+        std::vector<size_t>              order;
+        std::vector<BarGraphLabelFormat> fitted;
+
+        void layout(std::span<const float> distribution)
+        {
+            cachedDistribution.assign(distribution.begin(), distribution.end());
+            largestRemainderSplit(distribution, width, widths, order);
+            total = 0.0f;
+            for (float share : distribution) total += std::max(share, 0.0f);
+
+            fitted.resize(labels.size());
+            for (size_t i = 0; i < labels.size(); ++i)
+            {
+                float fraction = total > 0.0f ? std::max(distribution[i], 0.0f) / total : 0.0f;
+                fitted[i] = calculateBarGraphLabel(labels[i], fraction, widths[i], textLabels, percentageLabels);
+            }
+            layoutValid = true;
+        }
+    };
+
+
+    /**
+     * @brief Vertical bars growing up from a baseline, with eighth-block precision at the top of
+     * each bar (▁▂▃▄▅▆▇█). Only columns whose quantized height changed are redrawn.
+     */
+    class Histogram
+    {
+    public:
+        /**
+         * @param height   Rows the bars can fill
+         * @param barWidth Cells per bar
+         * @param gap      Blank cells between bars
+         * @param color    Bar colour name
+         * @param bgColor  Background colour name
+         */
+        Histogram(int height, int barWidth = 1, int gap = 0,
+                  const std::string& color = "green", const std::string& bgColor = "black")
+            : height(std::max(height, 0))
+            , barWidth(std::max(barWidth, 1))
+            , gap(std::max(gap, 0))
+            , attr(COLOR_PAIR(Colors::lookupColorPairByName(color, bgColor)))
+        {
+            for (size_t eighths = 0; eighths < 9; ++eighths)
+            {
+                for (int i = 0; i < this->barWidth; ++i) runs[eighths] += lowerEighths[eighths];
+            }
+        }
+
+        /**
+         * @brief Draw one bar per value with its top row at y. Each bar is value / maxValue of the
+         * full height; maxValue 0 scales to the largest value.
+         * @return Number of bars redrawn
+         */
+        size_t draw(WINDOW* win, int y, int x, std::span<const float> values, float maxValue = 0.0f)
+        {
+            if (!win) return 0;
+            if (win != lastWindow || y != lastY || x != lastX || values.size() != shown.size())
+            {
+                shown.assign(values.size(), -1);
+                lastWindow = win;
+                lastY = y;
+                lastX = x;
+            }
+
+            float scale = maxValue;
+            if (scale <= 0.0f)
+            {
+                for (float value : values) scale = std::max(scale, value);
+            }
+
+            const int fullUnits = height * 8;
+            size_t redrawn = 0;
+            wattron(win, attr);
+            for (size_t i = 0; i < values.size(); ++i)
+            {
+                float fraction = scale > 0.0f ? std::clamp(values[i] / scale, 0.0f, 1.0f) : 0.0f;
+                int units = static_cast<int>(std::lround(fraction * fullUnits));
+                if (units == shown[i]) continue;
+                shown[i] = units;
+                ++redrawn;
+
+                const int column = x + static_cast<int>(i) * (barWidth + gap);
+                for (int row = 0; row < height; ++row)
+                {
+                    // Units covering this row, counted up from the baseline
+                    int rowUnits = std::clamp(units - (height - 1 - row) * 8, 0, 8);
+                    const std::string& run = runs[rowUnits];
+                    mvwaddnstr(win, y + row, column, run.data(), static_cast<int>(run.size()));
+                }
+            }
+            wattroff(win, attr);
+            return redrawn;
+        }
+
+        /** @brief Redraw every bar on the next draw(), e.g. after werase(). */
+        void invalidate() { shown.clear(); }
+
+        /** @brief Cells across for n bars */
+        int widthFor(size_t bars) const
+        {
+            return bars == 0 ? 0 : static_cast<int>(bars) * (barWidth + gap) - gap;
+        }
+
+    private:
+        // Blank, then U+2581..U+2588: one to eight eighths, bottom-aligned
+        static constexpr std::string_view lowerEighths[9] = {
+            " ", "\xE2\x96\x81", "\xE2\x96\x82", "\xE2\x96\x83", "\xE2\x96\x84",
+            "\xE2\x96\x85", "\xE2\x96\x86", "\xE2\x96\x87", "\xE2\x96\x88"
+        };
+
+        int              height;
+        int              barWidth;
+        int              gap;
+        attr_t           attr;
+        std::string      runs[9];    // each lowerEighths glyph repeated barWidth times
+        std::vector<int> shown;      // units drawn per bar; -1 = not drawn
+        WINDOW*          lastWindow = nullptr;
+        int              lastY = 0, lastX = 0;
+    };
+
+
+    /**
+     * @brief Groups of horizontal bars, one bar per series in each group, all on one scale.
+     *
+     * Each group takes one row per series plus a blank row after it; its label sits in a
+     * column of labelWidth cells to the left of its first bar. Bars are drawn with eighth-block
+     * precision by one BarRenderer per series, so unchanged bars are skipped.
+     */
+    class GroupedBarChart
+    {
+    public:
+        /**
+         * @param groupLabels  One label per group, truncated to labelWidth - 1
+         * @param seriesColors Bar colour name per series
+         * @param barWidth     Cells for a bar at the maximum value
+         * @param labelWidth   Cells reserved for group labels
+         */
+        GroupedBarChart(const std::vector<std::string>& groupLabels,
+                        const std::vector<std::string>& seriesColors,
+                        int barWidth,
+                        int labelWidth = 12)
+            : labelWidth(std::max(labelWidth, 0))
+            , barWidth(std::max(barWidth, 0))
+        {
+            for (const std::string& label : groupLabels)
+            {
+                // Cut and pad by display columns, so no codepoint is split and the bars line up
+                std::string fitted = stevensStringLib::resizeToDisplayWidth(
+                    label, static_cast<size_t>(std::max(this->labelWidth - 1, 0)));
+                labels.push_back(stevensStringLib::resizeToDisplayWidth(fitted, static_cast<size_t>(this->labelWidth)));
+            }
+            for (const std::string& color : seriesColors)
+            {
+                BarSpec spec;
+                spec.width = this->barWidth;
+                spec.fillBgColor = color;
+                spec.showPct = false;
+                series.emplace_back(spec, BarRenderer::Precision::Eighth);
+            }
+        }
+
+        /** @brief Rows the chart takes */
+        int height() const
+        {
+            return labels.empty() ? 0 : static_cast<int>(labels.size() * (series.size() + 1)) - 1;
+        }
+
+        /**
+         * @brief Draw the chart with its top-left corner at (y, x)
+         * @param values    groups x series values, group-major: values[g * series + s]
+         * @param maxValue  The value of a full-width bar; 0 scales to the largest value
+         * @return Number of bars redrawn, or 0 if values has the wrong size
+         */
+        size_t draw(WINDOW* win, int y, int x, std::span<const float> values, float maxValue = 0.0f)
+        {
+            if (!win || values.size() != labels.size() * series.size()) return 0;
+            float scale = maxValue;
+            if (scale <= 0.0f)
+            {
+                for (float value : values) scale = std::max(scale, value);
+            }
+
+            // Bar lengths in eighths of a cell, so BarRenderer quantizes exactly
+            const int fullUnits = std::max(barWidth * 8, 1);
+            size_t redrawn = 0;
+            int row = y;
+            for (size_t group = 0; group < labels.size(); ++group)
+            {
+                mvwaddnstr(win, row, x, labels[group].data(), static_cast<int>(labels[group].size()));
+                for (size_t s = 0; s < series.size(); ++s, ++row)
+                {
+                    float value = values[group * series.size() + s];
+                    float fraction = scale > 0.0f ? std::clamp(value / scale, 0.0f, 1.0f) : 0.0f;
+                    redrawn += series[s].draw(win, row, x + labelWidth,
+                                              static_cast<int>(std::lround(fraction * fullUnits)), fullUnits);
+                }
+                ++row;
+            }
+            return redrawn;
+        }
+
+        /** @brief Redraw every bar on the next draw(), e.g. after werase(). */
+        void invalidate()
+        {
+            for (BarRenderer& renderer : series) renderer.invalidate();
+        }
+
+    private:
+        int                      labelWidth;
+        int                      barWidth;
+        std::vector<std::string> labels;   // padded to labelWidth display columns
+        std::vector<BarRenderer> series;
+    };
+
+} // namespace stevensTerminal
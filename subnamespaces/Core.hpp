@@ -306,6 +306,14 @@ namespace stevensTerminal
     bool displayMode_LTEmaxSize(std::pair<int,int> maxSize, std::pair<int,int> screenSize);
 
 
+    /**
+     * @brief Name of the display mode that matches a screen size
+     * @param screenSize Terminal dimensions (width, height)
+     * @return The first mode in displayModes whose bounds contain screenSize, or "regular"
+     */
+    std::string displayModeFor(std::pair<int,int> screenSize);
+
+
     /**
      * @brief Set display mode based on current screen size
      * @param screenSize Current terminal dimensions
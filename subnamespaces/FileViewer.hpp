@@ -0,0 +1,432 @@
+#pragma once
+/**
+ * @file FileViewer.hpp
+ * @brief Memory-mapped, lazily line-indexed file viewer for very large text files.
+ *
+ * curses_wprintFile() copies the whole file into a std::string and runs all of it through the
+ * tokenizer and wrapper on every call - fine for a help screen, unusable for a 300 MB log.
+ * FileViewer maps the file instead, indexes line starts on a background thread, and only
+ * tokenizes/wraps the lines that are actually on screen (it is a ScrollList whose items are the
+ * file's lines). Opening is O(1); memory use is the sparse line index plus the text and row
+ * heights of the lines around the view, however long the file is.
+ *
+ * Usage:
+ *   stevensTerminal::FileViewer viewer(win, "logs/game.log");
+ *   viewer.render();
+ *   viewer.jumpToLine(120000);  // applied as soon as the index reaches that line
+ *   viewer.scrollBy(-10);
+ *   viewer.search("ERROR");     // background search; matches are highlighted as they arrive
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include "Core.hpp"
+#include "ScrollList.hpp"
+#include "TextSearch.hpp"
+
+#if defined(__linux__)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace stevensTerminal
+{
+    /**
+     * @brief Read-only memory mapping of a whole file (RAII).
+     *
+     * Throws std::invalid_argument if the file can't be opened, matching curses_wprintFile().
+     * An empty file maps to data() == nullptr, size() == 0.
+     */
+    class MappedFile
+    {
+    public:
+        explicit MappedFile(const std::string& filePath)
+        {
+        #if defined(__linux__)
+            int fd = open(filePath.c_str(), O_RDONLY);
+            if (fd < 0) throw std::invalid_argument("Error, could not find file: " + filePath);
+            struct stat info;
+            if (fstat(fd, &info) != 0)
+            {
+                close(fd);
+                throw std::invalid_argument("Error, could not find file: " + filePath);
+            }
+            length = static_cast<size_t>(info.st_size);
+            if (length > 0)
+            {
+                void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (mapped == MAP_FAILED)
+                {
+                    close(fd);
+                    throw std::invalid_argument("Error, could not map file: " + filePath);
+                }
+                // The indexer reads front to back; let the kernel read ahead aggressively
+                madvise(mapped, length, MADV_SEQUENTIAL);
+                bytes = static_cast<const char*>(mapped);
+            }
+            close(fd); // the mapping keeps its own reference to the file
+        #elif defined(_WIN32)
+            fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE,
+                                     nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (fileHandle == INVALID_HANDLE_VALUE)
+                throw std::invalid_argument("Error, could not find file: " + filePath);
+            LARGE_INTEGER fileSize;
+            GetFileSizeEx(fileHandle, &fileSize);
+            length = static_cast<size_t>(fileSize.QuadPart);
+            if (length > 0)
+            {
+                mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                if (mappingHandle)
+                    bytes = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+                if (!bytes)
+                {
+                    release();
+                    throw std::invalid_argument("Error, could not map file: " + filePath);
+                }
+            }
+        #endif
+        }
+
+        ~MappedFile() { release(); }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        const char* data() const { return bytes; }
+        size_t size() const { return length; }
+        std::string_view view() const { return bytes ? std::string_view(bytes, length) : std::string_view(); }
+
+    private:
+        const char* bytes  = nullptr;
+        size_t      length = 0;
+    #if defined(_WIN32)
+        HANDLE fileHandle    = INVALID_HANDLE_VALUE;
+        HANDLE mappingHandle = nullptr;
+    #endif
+
+        void release()
+        {
+        #if defined(__linux__)
+            if (bytes) munmap(const_cast<char*>(bytes), length);
+        #elif defined(_WIN32)
+            if (bytes) UnmapViewOfFile(bytes);
+            if (mappingHandle) CloseHandle(mappingHandle);
+            if (fileHandle != INVALID_HANDLE_VALUE) CloseHandle(fileHandle);
+            mappingHandle = nullptr;
+            fileHandle = INVALID_HANDLE_VALUE;
+        #endif
+            bytes = nullptr;
+        }
+    };
+
+
+    /**
+     * @brief Sparse line-start index over a block of text, built on a background thread.
+     *
+     * Only every CHECKPOINT_INTERVAL-th line start is stored, so a 6M-line log costs ~750 KB of
+     * index instead of 48 MB; lineAt() finds the rest with a short memchr() scan from the nearest
+     * checkpoint. Lines already indexed are usable while the scan is still running.
+     */
+    class LineIndex
+    {
+    public:
+        static constexpr size_t CHECKPOINT_INTERVAL = 64;
+
+        explicit LineIndex(std::string_view textParam)
+            : text(textParam)
+        {
+            checkpoints.push_back(0);
+            worker = std::thread([this] { build(); });
+        }
+
+        ~LineIndex()
+        {
+            cancelled.store(true, std::memory_order_relaxed);
+            if (worker.joinable()) worker.join();
+        }
+
+        LineIndex(const LineIndex&) = delete;
+        LineIndex& operator=(const LineIndex&) = delete;
+
+        /** @brief Lines whose start is known so far (the final line count once isComplete()). */
+        size_t lineCount() const { return linesIndexed.load(std::memory_order_acquire); }
+
+        bool isComplete() const { return complete.load(std::memory_order_acquire); }
+
+        /** @brief Block until the background scan has finished. */
+        void wait()
+        {
+            if (worker.joinable()) worker.join();
+        }
+
+        /**
+         * @brief The text of line `index` (without its '\n' or a trailing '\r').
+         * @return An empty view if the line hasn't been indexed (yet).
+         */
+        std::string_view lineAt(size_t index) const
+        {
+            if (index >= lineCount()) return {};
+
+            size_t offset;
+            {
+                std::lock_guard<std::mutex> lock(checkpointMutex);
+                offset = checkpoints[index / CHECKPOINT_INTERVAL];
+            }
+            for (size_t skip = index % CHECKPOINT_INTERVAL; skip > 0; --skip)
+            {
+                const void* newline = std::memchr(text.data() + offset, '\n', text.size() - offset);
+                offset = static_cast<const char*>(newline) - text.data() + 1;
+            }
+
+            const void* newline = std::memchr(text.data() + offset, '\n', text.size() - offset);
+            size_t end = newline ? static_cast<size_t>(static_cast<const char*>(newline) - text.data()) : text.size();
+            if (end > offset && text[end - 1] == '\r') --end;
+            return text.substr(offset, end - offset);
+        }
+
+    private:
+        std::string_view    text;
+        std::vector<size_t> checkpoints;
+        mutable std::mutex  checkpointMutex;
+        std::atomic<size_t> linesIndexed{0};
+        std::atomic<bool>   complete{false};
+        std::atomic<bool>   cancelled{false};
+        std::thread         worker;
+
+        void build()
+        {
+            const char* begin = text.data();
+            const char* end   = begin + text.size();
+            const char* pos   = begin;
+            size_t lines = 0;
+
+            while (pos < end && !cancelled.load(std::memory_order_relaxed))
+            {
+                const void* newline = std::memchr(pos, '\n', static_cast<size_t>(end - pos));
+                if (!newline)
+                {
+                    ++lines; // last line has no terminating newline
+                    break;
+                }
+                pos = static_cast<const char*>(newline) + 1;
+                ++lines;
+                if (lines % CHECKPOINT_INTERVAL == 0 && pos < end)
+                {
+                    std::lock_guard<std::mutex> lock(checkpointMutex);
+                    checkpoints.push_back(static_cast<size_t>(pos - begin));
+                }
+                // Publish progress in batches so readers see lines become available while scanning
+                if (lines % CHECKPOINT_INTERVAL == 0)
+                {
+                    linesIndexed.store(lines, std::memory_order_release);
+                }
+            }
+            linesIndexed.store(lines, std::memory_order_release);
+            complete.store(true, std::memory_order_release);
+        }
+    };
+
+
+    /**
+     * @brief Spec for a FileViewer.
+     *
+     * wrap          — wrap long lines across several rows instead of clipping them
+     * avoidBorders  — keep the text inside a 1-character border on every side of the window
+     * style         — style applied to text not covered by an inline style token
+     * matchAttr     — attribute added to the cells of search matches
+     */
+    struct FileViewerSpec
+    {
+        bool   wrap         = true;
+        bool   avoidBorders = true;
+        std::unordered_map<std::string,std::string> style = {};
+        chtype matchAttr    = A_REVERSE;
+    };
+
+
+    /**
+     * @brief Scrollable view of a (possibly huge) text file in a curses window.
+     */
+    class FileViewer
+    {
+    public:
+        FileViewer(WINDOW* window, const std::string& filePath, FileViewerSpec specParam = {})
+            : win(window)
+            , file(filePath)
+            , index(file.view())
+            , spec(std::move(specParam))
+            , list(window, 0, [this](size_t line) { return std::string(index.lineAt(line)); }, listSpec(spec))
+        {
+            list.setItemDecorator([this](WINDOW* pad, int, size_t line, const std::string&,
+                                         const PrintHelper::PrintLayout& layout) {
+                highlights.apply(pad, line, layout, spec.matchAttr);
+            });
+        }
+
+        /** @brief Scroll by a number of lines (negative scrolls up). */
+        void scrollBy(long lines)
+        {
+            pendingJump = NO_LINE;
+            syncLineCount();
+            list.scrollBy(lines);
+        }
+
+        /**
+         * @brief Put `line` (0-based) at the top of the view.
+         *
+         * If the background index hasn't reached that line yet, the jump is remembered and
+         * applied by render() as soon as it has.
+         */
+        void jumpToLine(size_t line)
+        {
+            syncLineCount();
+            if (line < index.lineCount() || index.isComplete())
+            {
+                pendingJump = NO_LINE;
+                list.scrollBy(static_cast<long>(line) - static_cast<long>(list.top()));
+            }
+            else
+            {
+                pendingJump = line;
+            }
+        }
+
+        /** @brief Index of the line at the top of the view. */
+        size_t topLine() const { return list.top(); }
+
+        /** @brief Lines indexed so far (the file's total line count once indexingComplete()). */
+        size_t lineCount() const { return index.lineCount(); }
+
+        bool indexingComplete() const { return index.isComplete(); }
+
+        /** @brief Block until the whole file has been indexed. */
+        void waitForIndex() { index.wait(); }
+
+        /** @brief Direct access to a line's text, without tokenizing or wrapping it. */
+        std::string_view lineAt(size_t line) const { return index.lineAt(line); }
+
+        /**
+         * @brief Start searching the file for `needle` on a background thread, replacing any
+         * previous search. Matches are highlighted by render() as they are found.
+         */
+        void search(const std::string& needle)
+        {
+            searcher.start(file.view(), needle);
+            highlights.clear();
+            matchLines.clear();
+            list.redraw();
+        }
+
+        /** @brief Cancel the current search and remove its highlights. */
+        void clearSearch()
+        {
+            searcher.cancel();
+            searcher.takeNewMatches();
+            highlights.clear();
+            matchLines.clear();
+            list.redraw();
+        }
+
+        /** @brief Matches found so far by the current search. */
+        size_t matchCount() const { return searcher.matchCount(); }
+
+        bool searchComplete() const { return searcher.isDone(); }
+
+        /**
+         * @brief Scroll to the first line after the top line that contains a match (found so far).
+         * @return false if there is no such line yet.
+         */
+        bool jumpToNextMatch()
+        {
+            collectMatches();
+            auto next = std::upper_bound(matchLines.begin(), matchLines.end(), topLine());
+            if (next == matchLines.end()) return false;
+            jumpToLine(*next);
+            return true;
+        }
+
+        /** @brief Scroll to the last line before the top line that contains a match. */
+        bool jumpToPreviousMatch()
+        {
+            collectMatches();
+            auto prev = std::lower_bound(matchLines.begin(), matchLines.end(), topLine());
+            if (prev == matchLines.begin()) return false;
+            jumpToLine(*std::prev(prev));
+            return true;
+        }
+
+        /**
+         * @brief Draw the visible lines. Only those lines are tokenized and wrapped.
+         */
+        void render()
+        {
+            syncLineCount();
+            if (pendingJump != NO_LINE) jumpToLine(pendingJump);
+            collectMatches();
+
+            int winHeight, winWidth;
+            getmaxyx(win, winHeight, winWidth);
+            if (spec.avoidBorders) list.setRegion(1, 1, winHeight - 2, winWidth - 2);
+            else list.setRegion(0, 0, winHeight, winWidth);
+            list.render();
+        }
+
+    private:
+        static constexpr size_t NO_LINE = static_cast<size_t>(-1);
+
+        WINDOW*        win;
+        MappedFile     file;
+        LineIndex      index;
+        FileViewerSpec spec;
+        ScrollList     list;
+        size_t         pendingJump = NO_LINE;
+
+        TextSearch          searcher;
+        SearchHighlights    highlights;
+        std::vector<size_t> matchLines; // distinct lines with a match, ascending
+
+        static ScrollListSpec listSpec(const FileViewerSpec& viewerSpec)
+        {
+            ScrollListSpec result;
+            result.wrap = viewerSpec.wrap;
+            result.highlightSelection = false;
+            result.style = viewerSpec.style;
+            return result;
+        }
+
+        /**
+         * Pull matches the search worker found since the last call. Rows are only redrawn when a
+         * new match lands on a line that's already been drawn with its old (unhighlighted) look.
+         */
+        void collectMatches()
+        {
+            std::vector<SearchMatch> fresh = searcher.takeNewMatches();
+            if (fresh.empty()) return;
+            highlights.add(fresh);
+            bool visible = false;
+            for (const SearchMatch& match : fresh)
+            {
+                if (matchLines.empty() || matchLines.back() != match.line) matchLines.push_back(match.line);
+                if (match.line >= list.top() && match.line < list.top() + static_cast<size_t>(getmaxy(win)))
+                    visible = true;
+            }
+            if (visible) list.redraw();
+        }
+
+        void syncLineCount()
+        {
+            size_t lines = index.lineCount();
+            if (lines != list.size()) list.setItemCount(lines);
+        }
+    };
+
+} // namespace stevensTerminal
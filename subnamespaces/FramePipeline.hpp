@@ -0,0 +1,498 @@
+#pragma once
+/**
+ * @file FramePipeline.hpp
+ * @brief Optional parallel frame pipeline: rasterize panes off-screen on a thread pool, flush serially.
+ *
+ * With many panes on screen, frame time is the sum of every pane's tokenize + wrap work, all on
+ * the render thread. FramePipeline records each pane's print calls, and on renderFrame() every
+ * dirty pane is tokenized, laid out and rasterized into its own CellBuffer on the ThreadPool -
+ * no curses calls, so that part is safe to run in parallel. A single serial stage then copies
+ * the cells that changed since the last frame into the curses windows and calls doupdate().
+ *
+ * Rasterizing prints the same layout curses_wprint() does (PrintHelper::layoutPrint(): styles,
+ * inline tokens, "wrap", "avoid borders", "retain xmove on newline", "textAlign") and only swaps
+ * the window for cells, so a pane looks the same either way.
+ *
+ * Usage:
+ *   stevensTerminal::FramePipeline pipeline;
+ *   pipeline.beginPane(logWin);                    // replace this pane's content
+ *   pipeline.print(logWin, 1, 1, longText, {}, {{"wrap", "true"}});
+ *   pipeline.beginPane(statsWin);
+ *   pipeline.print(statsWin, 0, 0, "{HP}$[textColor=red] 42");
+ *   pipeline.renderFrame();                        // parallel rasterize, serial flush + doupdate()
+ */
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Core.hpp"
+#include "ThreadPool.hpp"
+
+namespace stevensTerminal
+{
+    /**
+     * @brief One screen cell: a UTF-8 glyph (with any combining marks) and its attributes.
+     *
+     * length == 0 marks the right half of a double-width glyph stored in the cell to its left.
+     */
+    struct Cell
+    {
+        std::array<char, 11> glyph  = {' '};
+        uint8_t              length = 1;
+        attr_t               attrs  = A_NORMAL;
+
+        bool operator==(const Cell& other) const
+        {
+            return length == other.length && attrs == other.attrs &&
+                   std::memcmp(glyph.data(), other.glyph.data(), length) == 0;
+        }
+    };
+
+
+    /**
+     * @brief A rows x cols grid of Cells - an off-screen stand-in for a curses window.
+     */
+    class CellBuffer
+    {
+    public:
+        CellBuffer(int rowsParam = 0, int colsParam = 0) { resize(rowsParam, colsParam); }
+
+        void resize(int rowsParam, int colsParam)
+        {
+            height = std::max(rowsParam, 0);
+            width  = std::max(colsParam, 0);
+            cells.assign(static_cast<size_t>(height) * width, Cell{});
+        }
+
+        void clear() { std::fill(cells.begin(), cells.end(), Cell{}); }
+
+        int rows() const { return height; }
+        int cols() const { return width; }
+
+        Cell&       at(int y, int x)       { return cells[static_cast<size_t>(y) * width + x]; }
+        const Cell& at(int y, int x) const { return cells[static_cast<size_t>(y) * width + x]; }
+
+        /** @brief The text of a row (trailing blanks included), for tests and debugging. */
+        std::string rowText(int y) const
+        {
+            std::string text;
+            for (int x = 0; x < width; ++x)
+            {
+                const Cell& cell = at(y, x);
+                text.append(cell.glyph.data(), cell.length);
+            }
+            return text;
+        }
+
+    private:
+        int               height = 0;
+        int               width  = 0;
+        std::vector<Cell> cells;
+    };
+
+
+    namespace CellRaster
+    {
+        /**
+         * @brief Attributes for a style map, as curses_styleAttributes() would turn on.
+         *
+         * Read-only on the colour tables, so it is safe to call from pool threads.
+         */
+        inline attr_t styleAttributes(const std::unordered_map<std::string,std::string>& style)
+        {
+            auto get = [&](const char* key) -> std::string {
+                auto it = style.find(key);
+                return it == style.end() ? std::string() : it->second;
+            };
+            std::string textColor = get("textColor");
+            std::string bgColor   = get("bgColor");
+            if (textColor == "default") textColor = Colors::curses_default_textColor;
+            if (bgColor == "default") bgColor = Colors::curses_default_backgroundColor;
+
+            attr_t attrs = A_NORMAL;
+            auto pair = Colors::curses_colorPairs.find(textColor + "_on_" + bgColor);
+            attrs |= COLOR_PAIR(pair == Colors::curses_colorPairs.end() ? 0 : pair->second);
+            if (get("blink") == "true")     attrs |= A_BLINK;
+            if (get("bold") == "true")      attrs |= A_BOLD;
+            if (get("underline") == "true") attrs |= A_UNDERLINE;
+            if (get("reverse") == "true")   attrs |= A_REVERSE;
+            if (get("dim") == "true")       attrs |= A_DIM;
+            if (get("italic") == "true")    attrs |= A_ITALIC;
+            return attrs;
+        }
+
+        /**
+         * @brief Attributes for a styled token, as curses_styleToken() would turn on.
+         */
+        inline attr_t tokenAttributes(const PrintToken& token)
+        {
+            std::string textColor = (token.textColor == "default" || token.textColor.empty())
+                ? Colors::curses_default_textColor : token.textColor;
+            std::string bgColor = (token.bgColor == "default" || token.bgColor.empty())
+                ? Colors::curses_default_backgroundColor : token.bgColor;
+
+            attr_t attrs = A_NORMAL;
+            auto pair = Colors::curses_colorPairs.find(textColor + "_on_" + bgColor);
+            attrs |= COLOR_PAIR(pair == Colors::curses_colorPairs.end() ? 0 : pair->second);
+            if (token.blink)     attrs |= A_BLINK;
+            if (token.bold)      attrs |= A_BOLD;
+            if (token.underline) attrs |= A_UNDERLINE;
+            if (token.reverse)   attrs |= A_REVERSE;
+            if (token.dim)       attrs |= A_DIM;
+            if (token.italic)    attrs |= A_ITALIC;
+            return attrs;
+        }
+
+        /**
+         * @brief Emulates waddstr() into a CellBuffer: a cursor that wraps at the right edge,
+         * handles '\n' like curses (clear to end of line, next row, column 0) and stops
+         * advancing at the bottom-right cell.
+         */
+        class Canvas
+        {
+        public:
+            explicit Canvas(CellBuffer& bufferParam) : buffer(bufferParam) {}
+
+            int y = 0;
+            int x = 0;
+
+            /** @brief wmove() - false (and the cursor unchanged) if out of range. */
+            bool move(int row, int col)
+            {
+                if (row < 0 || col < 0 || row >= buffer.rows() || col >= buffer.cols()) return false;
+                y = row;
+                x = col;
+                return true;
+            }
+
+            /** @brief mvwprintw(win, row, col, "%s", text) */
+            void print(int row, int col, const std::string& text, attr_t attrs)
+            {
+                if (!move(row, col)) return;
+                size_t i = 0;
+                while (i < text.size())
+                {
+                    size_t length = sequenceLength(static_cast<unsigned char>(text[i]));
+                    length = std::min(length, text.size() - i);
+                    put(text.data() + i, length, attrs);
+                    i += length;
+                }
+            }
+
+        private:
+            CellBuffer& buffer;
+
+            static size_t sequenceLength(unsigned char lead)
+            {
+                if (lead < 0x80) return 1;
+                if ((lead & 0xE0) == 0xC0) return 2;
+                if ((lead & 0xF0) == 0xE0) return 3;
+                if ((lead & 0xF8) == 0xF0) return 4;
+                return 1;
+            }
+
+            void advance()
+            {
+                if (x + 1 < buffer.cols())
+                {
+                    ++x;
+                }
+                else if (y + 1 < buffer.rows())
+                {
+                    x = 0;
+                    ++y;
+                }
+                // else: bottom-right cell - curses leaves the cursor there
+            }
+
+            void setCell(int row, int col, const char* bytes, size_t length, attr_t attrs)
+            {
+                Cell& cell = buffer.at(row, col);
+                length = std::min(length, cell.glyph.size());
+                std::memcpy(cell.glyph.data(), bytes, length);
+                cell.length = static_cast<uint8_t>(length);
+                cell.attrs = attrs;
+            }
+
+            void put(const char* bytes, size_t length, attr_t attrs)
+            {
+                if (buffer.rows() == 0 || buffer.cols() == 0) return;
+                unsigned char lead = static_cast<unsigned char>(bytes[0]);
+
+                if (lead == '\n')
+                {
+                    for (int col = x; col < buffer.cols(); ++col) setCell(y, col, " ", 1, attrs);
+                    if (y + 1 < buffer.rows())
+                    {
+                        ++y;
+                        x = 0;
+                    }
+                    return;
+                }
+                if (lead == '\t')
+                {
+                    int stop = (x / 8 + 1) * 8;
+                    while (x < stop && x < buffer.cols())
+                    {
+                        setCell(y, x, " ", 1, attrs);
+                        if (x + 1 >= buffer.cols()) { advance(); break; }
+                        ++x;
+                    }
+                    return;
+                }
+                if (lead < 0x20 || lead == 0x7F)
+                {
+                    // Control characters show as ^X, like unctrl()
+                    char caret[2] = {'^', static_cast<char>(lead == 0x7F ? '?' : lead + 64)};
+                    put(caret, 1, attrs);
+                    put(caret + 1, 1, attrs);
+                    return;
+                }
+
+                int width = 1;
+                if (lead >= 0x80)
+                {
+                    width = static_cast<int>(stevensStringLib::lineDisplayWidth(std::string(bytes, length)));
+                }
+
+                if (width == 0)
+                {
+                    // Combining mark: attach to the glyph before the cursor
+                    int row = y, col = x - 1;
+                    if (col < 0) return;
+                    if (buffer.at(row, col).length == 0 && col > 0) --col;
+                    Cell& cell = buffer.at(row, col);
+                    if (cell.length + length <= cell.glyph.size())
+                    {
+                        std::memcpy(cell.glyph.data() + cell.length, bytes, length);
+                        cell.length = static_cast<uint8_t>(cell.length + length);
+                    }
+                    return;
+                }
+
+                if (width == 2 && x + 1 >= buffer.cols())
+                {
+                    // Doesn't fit on this row: pad it out and wrap, as curses does
+                    setCell(y, x, " ", 1, attrs);
+                    if (y + 1 >= buffer.rows()) return;
+                    advance();
+                }
+
+                setCell(y, x, bytes, length, attrs);
+                if (width == 2)
+                {
+                    advance();
+                    Cell& right = buffer.at(y, x);
+                    right.length = 0;
+                    right.attrs = attrs;
+                }
+                advance();
+            }
+        };
+
+        /**
+         * @brief curses_wprint() into a CellBuffer instead of a window.
+         *
+         * The layout comes from PrintHelper::layoutPrint(), the same step curses_wprint() prints from;
+         * only the final put-text-in-cells step differs.
+         *
+         * @param textStylingParam Same as curses_wprint()'s textStyling argument.
+         */
+        inline void print(CellBuffer& buffer,
+                          int yMove,
+                          int xMove,
+                          std::string input,
+                          std::unordered_map<std::string,std::string> style,
+                          std::unordered_map<std::string,std::string> format,
+                          bool textStylingParam)
+        {
+            PrintHelper::PrintLayout layout = PrintHelper::layoutPrint(buffer.rows(), buffer.cols(), yMove, xMove,
+                                                                       std::move(input), std::move(style),
+                                                                       std::move(format), textStylingParam);
+            Canvas canvas(buffer);
+            attr_t styleAttrs = layout.styled ? styleAttributes(layout.style) : A_NORMAL;
+
+            for (const PrintHelper::PrintRun& run : layout.runs)
+            {
+                attr_t attrs = !layout.styled ? A_NORMAL
+                             : run.token >= 0 ? tokenAttributes(layout.tokens[run.token])
+                             : styleAttrs;
+                if (run.atCursor)
+                {
+                    canvas.print(canvas.y, canvas.x, run.text, attrs);
+                }
+                else
+                {
+                    canvas.print(run.y, run.x, run.text, attrs);
+                }
+            }
+        }
+
+    } // namespace CellRaster
+
+
+    /**
+     * @brief Records per-pane print calls; renders dirty panes in parallel, flushes them serially.
+     */
+    class FramePipeline
+    {
+    public:
+        explicit FramePipeline(ThreadPool& poolParam = defaultThreadPool())
+            : pool(poolParam)
+        {}
+
+        /**
+         * @brief Start replacing a pane's content. The pane is cleared and re-rendered next frame.
+         */
+        void beginPane(WINDOW* win)
+        {
+            Pane& pane = panes[win];
+            pane.ops.clear();
+            pane.dirty = true;
+        }
+
+        /**
+         * @brief Add a curses_wprint() call to a pane's content (arguments as for curses_wprint()).
+         */
+        void print(WINDOW* win, int y, int x, std::string text,
+                   std::unordered_map<std::string,std::string> style = {},
+                   std::unordered_map<std::string,std::string> format = {})
+        {
+            Pane& pane = panes[win];
+            pane.ops.push_back(PrintOp{y, x, std::move(text), std::move(style), std::move(format)});
+            pane.dirty = true;
+        }
+
+        /** @brief Stop managing a pane (e.g. before deleting its window). */
+        void removePane(WINDOW* win) { panes.erase(win); }
+
+        /**
+         * @brief Rasterize every dirty pane on the pool, then copy changed cells into the windows.
+         *
+         * @param update Call doupdate() after staging the panes with wnoutrefresh(). Pass false
+         *               when something else (e.g. WindowManager::refreshAll()) finishes the frame.
+         */
+        void renderFrame(bool update = true)
+        {
+            dirtyPanes.clear();
+            for (auto& [win, pane] : panes)
+            {
+                if (!pane.dirty) continue;
+                int rows, cols;
+                getmaxyx(win, rows, cols);
+                if (pane.next.rows() != rows || pane.next.cols() != cols)
+                {
+                    pane.next.resize(rows, cols);
+                }
+                dirtyPanes.push_back(&pane);
+            }
+            lastRasterized = dirtyPanes.size();
+
+            bool styling = textStyling;
+            pool.parallelFor(dirtyPanes.size(), [this, styling](size_t i) {
+                Pane& pane = *dirtyPanes[i];
+                pane.next.clear();
+                for (const PrintOp& op : pane.ops)
+                {
+                    CellRaster::print(pane.next, op.y, op.x, op.text, op.style, op.format, styling);
+                }
+            });
+
+            for (auto& [win, pane] : panes)
+            {
+                if (!pane.dirty) continue;
+                flush(win, pane);
+                pane.dirty = false;
+                wnoutrefresh(win);
+            }
+            if (update) doupdate();
+        }
+
+        /** @brief Panes rasterized by the last renderFrame(). */
+        size_t rasterizedCount() const { return lastRasterized; }
+
+        /** @brief A pane's last rasterized cells, or nullptr if the window isn't a pane. */
+        const CellBuffer* buffer(WINDOW* win) const
+        {
+            auto it = panes.find(win);
+            return it == panes.end() ? nullptr : &it->second.shown;
+        }
+
+    private:
+        struct PrintOp
+        {
+            int         y;
+            int         x;
+            std::string text;
+            std::unordered_map<std::string,std::string> style;
+            std::unordered_map<std::string,std::string> format;
+        };
+
+        struct Pane
+        {
+            std::vector<PrintOp> ops;
+            CellBuffer           next;   // rasterized this frame
+            CellBuffer           shown;  // what the window holds
+            bool                 dirty = true;
+            bool                 flushed = false;
+        };
+
+        ThreadPool&                         pool;
+        std::unordered_map<WINDOW*, Pane>   panes;
+        std::vector<Pane*>                  dirtyPanes;
+        size_t                              lastRasterized = 0;
+
+        /**
+         * Copy the cells that differ from what the window already shows, one attribute run at a
+         * time, so an unchanged pane costs a comparison per cell and no curses calls.
+         */
+        void flush(WINDOW* win, Pane& pane)
+        {
+            const CellBuffer& next = pane.next;
+            bool full = !pane.flushed || pane.shown.rows() != next.rows() || pane.shown.cols() != next.cols();
+            std::string run;
+
+            for (int y = 0; y < next.rows(); ++y)
+            {
+                int x = 0;
+                while (x < next.cols())
+                {
+                    if (!full && next.at(y, x) == pane.shown.at(y, x))
+                    {
+                        ++x;
+                        continue;
+                    }
+                    int start = x;
+                    if (next.at(y, start).length == 0 && start > 0) --start; // start on the glyph
+                    attr_t attrs = next.at(y, start).attrs;
+                    run.clear();
+                    x = start;
+                    while (x < next.cols() && next.at(y, x).attrs == attrs &&
+                           (full || !(next.at(y, x) == pane.shown.at(y, x)) || next.at(y, x).length == 0))
+                    {
+                        const Cell& cell = next.at(y, x);
+                        run.append(cell.glyph.data(), cell.length);
+                        ++x;
+                    }
+                    if (x == start)
+                    {
+                        // Attribute change on a continuation cell - emit the glyph alone
+                        const Cell& cell = next.at(y, x);
+                        run.append(cell.glyph.data(), cell.length);
+                        ++x;
+                    }
+                    wattrset(win, attrs);
+                    mvwaddstr(win, y, start, run.c_str());
+                }
+            }
+            wattrset(win, A_NORMAL);
+            pane.shown = next;
+            pane.flushed = true;
+        }
+    };
+
+} // namespace stevensTerminal
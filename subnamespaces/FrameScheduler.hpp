@@ -0,0 +1,207 @@
+#pragma once
+/**
+ * @file FrameScheduler.hpp
+ * @brief Fixed-rate frame pacing with measured delta times and frame-time statistics.
+ *
+ * Frames are scheduled against absolute deadlines (start + n * period) rather than by sleeping a
+ * fixed amount after each frame, so time spent updating and rendering doesn't accumulate as drift.
+ * A frame that starts more than a whole period late is counted as missed and the schedule is
+ * re-anchored, instead of bursting through the backlog to catch up.
+ *
+ * Usage:
+ *   stevensTerminal::FrameScheduler frames(60.0);
+ *   frames.run([&](float dt) {
+ *       effect.update(dt);
+ *       return !effect.isFinished();
+ *   }, [&] {
+ *       effect.render();
+ *   });
+ *   stevensTerminal::FrameStats stats = frames.stats();  // p50 / p99 / max frame time, missed frames
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+    #include <ncurses.h>
+#elif defined(_WIN32) || defined(__MSDOS__)
+    #include <curses.h>
+#endif
+
+namespace stevensTerminal
+{
+    /**
+     * @brief Frame-time statistics over the scheduler's recent history.
+     *
+     * p50Ms / p99Ms / maxMs — time spent inside frames (beginFrame() to endFrame()), milliseconds
+     * meanIntervalMs        — mean time between consecutive frame starts, milliseconds
+     * targetMs              — the frame period being aimed for
+     * frames                — frames completed since construction or resetStats()
+     * missedFrames          — frame deadlines skipped because a frame started a period or more late
+     */
+    struct FrameStats
+    {
+        double   p50Ms          = 0.0;
+        double   p99Ms          = 0.0;
+        double   maxMs          = 0.0;
+        double   meanIntervalMs = 0.0;
+        double   targetMs       = 0.0;
+        uint64_t frames         = 0;
+        uint64_t missedFrames   = 0;
+    };
+
+    /**
+     * @brief Runs update -> render -> doupdate() at a target frame rate.
+     *
+     * Use run() for a self-contained loop, or beginFrame()/endFrame() around an existing one.
+     */
+    class FrameScheduler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        /**
+         * @param targetFps    Frames per second to aim for.
+         * @param historySize  Number of recent frames the percentiles are computed over.
+         * @param maxDeltaSec  Upper bound on the delta time handed out, so one long stall
+         *                     (a debugger, a blocking prompt) doesn't become one huge physics step.
+         */
+        explicit FrameScheduler(double targetFps = 60.0, size_t historySize = 240, float maxDeltaSec = 0.25f)
+            : history(std::max<size_t>(historySize, 1), 0.0)
+            , maxDelta(maxDeltaSec)
+        {
+            setTargetFps(targetFps);
+        }
+
+        void setTargetFps(double targetFps)
+        {
+            targetFps = std::max(targetFps, 0.001);
+            period = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / targetFps));
+            started = false; // re-anchor the schedule at the next frame
+        }
+
+        double targetFps() const
+        {
+            return 1.0 / std::chrono::duration<double>(period).count();
+        }
+
+        /**
+         * @brief Wait for the next frame deadline and start a frame.
+         * @return Seconds since the previous frame started (one period for the first frame),
+         *         clamped to maxDeltaSec.
+         */
+        float beginFrame()
+        {
+            Clock::time_point now = Clock::now();
+            if (!started)
+            {
+                started = true;
+                nextDeadline = now;
+                frameStart = now - period;
+            }
+
+            if (now >= nextDeadline + period)
+            {
+                // A period or more behind: count the skipped deadlines and re-anchor
+                missed += static_cast<uint64_t>((now - nextDeadline) / period);
+                nextDeadline = now;
+            }
+            else if (now < nextDeadline)
+            {
+                std::this_thread::sleep_until(nextDeadline);
+                now = Clock::now();
+            }
+            nextDeadline += period;
+
+            float delta = std::chrono::duration<float>(now - frameStart).count();
+            intervalTotal += now - frameStart;
+            frameStart = now;
+            inFrame = true;
+            return std::min(delta, maxDelta);
+        }
+
+        /**
+         * @brief Finish the frame started by beginFrame() and record how long it took.
+         */
+        void endFrame()
+        {
+            if (!inFrame) return;
+            inFrame = false;
+            double ms = std::chrono::duration<double, std::milli>(Clock::now() - frameStart).count();
+            history[frameCount % history.size()] = ms;
+            ++frameCount;
+        }
+
+        /**
+         * @brief Run frames until update() returns false.
+         *
+         * Each frame calls update(deltaSeconds), then render(), then doupdate() to push the windows
+         * render() staged with wnoutrefresh() to the terminal.
+         */
+        void run(const std::function<bool(float deltaSeconds)>& update, const std::function<void()>& render)
+        {
+            while (true)
+            {
+                float delta = beginFrame();
+                bool keepGoing = update(delta);
+                if (keepGoing)
+                {
+                    render();
+                    doupdate();
+                }
+                endFrame();
+                if (!keepGoing) break;
+            }
+        }
+
+        /** @brief Number of frames completed. */
+        uint64_t frameIndex() const { return frameCount; }
+
+        FrameStats stats() const
+        {
+            FrameStats result;
+            result.targetMs = std::chrono::duration<double, std::milli>(period).count();
+            result.frames = frameCount;
+            result.missedFrames = missed;
+            if (frameCount == 0) return result;
+
+            std::vector<double> recent(history.begin(), history.begin() + std::min<uint64_t>(frameCount, history.size()));
+            std::sort(recent.begin(), recent.end());
+            auto percentile = [&](double p) {
+                size_t rank = static_cast<size_t>(std::ceil(p * recent.size()));
+                return recent[std::clamp<size_t>(rank, 1, recent.size()) - 1];
+            };
+            result.p50Ms = percentile(0.50);
+            result.p99Ms = percentile(0.99);
+            result.maxMs = recent.back();
+            result.meanIntervalMs = std::chrono::duration<double, std::milli>(intervalTotal).count() / frameCount;
+            return result;
+        }
+
+        void resetStats()
+        {
+            std::fill(history.begin(), history.end(), 0.0);
+            frameCount = 0;
+            missed = 0;
+            intervalTotal = Clock::duration::zero();
+        }
+
+    private:
+        std::vector<double> history;  // ring buffer of frame durations, ms
+        float               maxDelta;
+        Clock::duration     period{};
+        Clock::time_point   nextDeadline{};
+        Clock::time_point   frameStart{};
+        Clock::duration     intervalTotal = Clock::duration::zero();
+        uint64_t            frameCount = 0;
+        uint64_t            missed     = 0;
+        bool                started    = false;
+        bool                inFrame    = false;
+    };
+
+} // namespace stevensTerminal
@@ -0,0 +1,345 @@
+#pragma once
+/**
+ * @file Layout.hpp
+ * @brief Declarative row/column layout solved into WindowSpecs for the WindowManager.
+ *
+ * Instead of computing a WindowSpec for every window by hand on each resize, describe the screen
+ * once as a tree of rows and columns whose children have fixed, min/max-bounded or flexible sizes,
+ * optionally with a different tree per DisplayMode. Layout solves the tree once per terminal size
+ * (results are cached), and apply() only reconfigures windows whose geometry actually changed -
+ * configureWindow() erases a window, so skipping unchanged ones avoids a full repaint.
+ *
+ * Usage:
+ *   using stevensTerminal::LayoutNode;
+ *   using stevensTerminal::LayoutSize;
+ *   stevensTerminal::Layout layout(LayoutNode::column({
+ *       LayoutNode::window("header", LayoutSize::exactly(3)),
+ *       LayoutNode::row({
+ *           LayoutNode::window("menu", LayoutSize::weighted(1, 18, 30)),
+ *           LayoutNode::window("art",  LayoutSize::weighted(3)),
+ *       }),
+ *       LayoutNode::window("prompt", LayoutSize::exactly(2)),
+ *   }));
+ *   layout.addBreakpoint("very small", LayoutNode::column({ ... }));
+ *   layout.apply(stevensTerminal::windowManager());   // on startup and on every resize
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Core.hpp"
+
+namespace stevensTerminal
+{
+    /**
+     * @brief Size of a layout node along its parent's main axis.
+     *
+     * fixed — exact size in cells; -1 makes the node flexible
+     * flex  — share of the space left after fixed siblings, relative to the other flexible siblings
+     * min   — lower bound in cells
+     * max   — upper bound in cells; -1 for none
+     */
+    struct LayoutSize
+    {
+        int    fixed = -1;
+        double flex  = 1.0;
+        int    min   = 0;
+        int    max   = -1;
+
+        static LayoutSize exactly(int cells)
+        {
+            LayoutSize size;
+            size.fixed = cells;
+            return size;
+        }
+
+        static LayoutSize weighted(double weight = 1.0, int minCells = 0, int maxCells = -1)
+        {
+            LayoutSize size;
+            size.flex = weight;
+            size.min = minCells;
+            size.max = maxCells;
+            return size;
+        }
+    };
+
+
+    /**
+     * @brief A node of a layout tree: a named window, or a row/column of child nodes.
+     *
+     * A row places its children left to right, a column top to bottom; every child fills its
+     * parent along the other axis.
+     */
+    struct LayoutNode
+    {
+        enum class Kind { Window, Row, Column };
+
+        Kind                    kind = Kind::Window;
+        std::string             name;
+        LayoutSize              size;
+        std::vector<LayoutNode> children;
+
+        static LayoutNode window(std::string windowName, LayoutSize nodeSize = {})
+        {
+            LayoutNode node;
+            node.kind = Kind::Window;
+            node.name = std::move(windowName);
+            node.size = nodeSize;
+            return node;
+        }
+
+        static LayoutNode row(std::vector<LayoutNode> nodeChildren, LayoutSize nodeSize = {})
+        {
+            LayoutNode node;
+            node.kind = Kind::Row;
+            node.children = std::move(nodeChildren);
+            node.size = nodeSize;
+            return node;
+        }
+
+        static LayoutNode column(std::vector<LayoutNode> nodeChildren, LayoutSize nodeSize = {})
+        {
+            LayoutNode node;
+            node.kind = Kind::Column;
+            node.children = std::move(nodeChildren);
+            node.size = nodeSize;
+            return node;
+        }
+    };
+
+
+    /**
+     * @brief Where one window ends up for a given terminal size.
+     */
+    struct LayoutPlacement
+    {
+        std::string name;
+        WindowSpec  spec;
+    };
+
+
+    /**
+     * @brief A layout tree (plus per-DisplayMode alternatives) with a per-terminal-size solve cache.
+     */
+    class Layout
+    {
+    public:
+        static constexpr size_t MAX_CACHED_SIZES = 32;
+
+        explicit Layout(LayoutNode rootParam)
+            : root(std::move(rootParam))
+        {}
+
+        /**
+         * @brief Use a different tree while `displayMode` (a key of displayModes) is the mode
+         * matching the terminal size.
+         *
+         * Windows missing from the active tree are left as they are.
+         */
+        void addBreakpoint(const std::string& displayMode, LayoutNode tree)
+        {
+            breakpoints[displayMode] = std::move(tree);
+            cache.clear();
+        }
+
+        /**
+         * @brief Window geometry for a terminal of `width` x `height` cells. Cached per size.
+         */
+        const std::vector<LayoutPlacement>& solve(int width, int height)
+        {
+            return solved(width, height).placements;
+        }
+
+        /**
+         * @brief Display mode whose tree solve()/apply() used for this size.
+         */
+        const std::string& displayModeAt(int width, int height)
+        {
+            return solved(width, height).displayMode;
+        }
+
+        /**
+         * @brief Configure the windows of `wm` for a `width` x `height` terminal.
+         *
+         * Windows whose geometry already matches are not touched (not resized, moved or erased).
+         * Names are resolved to WindowIds once per cached solution, creating windows as needed.
+         *
+         * @return Number of windows that were reconfigured.
+         */
+        size_t apply(WindowManager& wm, int width, int height)
+        {
+            Solved& result = solved(width, height);
+            if (result.resolvedFor != &wm || result.ids.size() != result.placements.size())
+            {
+                result.ids.clear();
+                for (const LayoutPlacement& placement : result.placements)
+                {
+                    result.ids.push_back(wm.getWindowId(placement.name));
+                }
+                result.resolvedFor = &wm;
+            }
+
+            size_t changed = 0;
+            for (size_t i = 0; i < result.placements.size(); ++i)
+            {
+                WindowId id = result.ids[i];
+                if (!wm.hasWindow(id) || wm.getWindowNames()[id.index] != result.placements[i].name)
+                {
+                    // The manager was cleaned up since these ids were resolved
+                    id = result.ids[i] = wm.getWindowId(result.placements[i].name);
+                }
+                if (wm.info(id).spec == result.placements[i].spec) continue;
+                wm.configureWindow(id, result.placements[i].spec);
+                ++changed;
+            }
+            return changed;
+        }
+
+        /** @brief apply() for the current terminal size. */
+        size_t apply(WindowManager& wm)
+        {
+            std::pair<int,int> screenSize = get_screen_size();
+            return apply(wm, screenSize.first, screenSize.second);
+        }
+
+    private:
+        struct Solved
+        {
+            std::string                  displayMode;
+            std::vector<LayoutPlacement> placements;
+            const WindowManager*         resolvedFor = nullptr;
+            std::vector<WindowId>        ids;
+        };
+
+        LayoutNode                                  root;
+        std::unordered_map<std::string, LayoutNode> breakpoints;
+        std::unordered_map<uint64_t, Solved>        cache;
+
+        Solved& solved(int width, int height)
+        {
+            width = std::max(width, 0);
+            height = std::max(height, 0);
+            uint64_t key = (static_cast<uint64_t>(static_cast<uint32_t>(width)) << 32) | static_cast<uint32_t>(height);
+            auto it = cache.find(key);
+            if (it != cache.end()) return it->second;
+
+            if (cache.size() >= MAX_CACHED_SIZES) cache.clear();
+
+            Solved result;
+            result.displayMode = displayModeFor({width, height});
+            auto breakpoint = breakpoints.find(result.displayMode);
+            const LayoutNode& tree = breakpoint != breakpoints.end() ? breakpoint->second : root;
+            place(tree, 0, 0, height, width, result.placements);
+            return cache.emplace(key, std::move(result)).first->second;
+        }
+
+        static void place(const LayoutNode& node, int top, int left, int height, int width,
+                          std::vector<LayoutPlacement>& out)
+        {
+            if (node.kind == LayoutNode::Kind::Window)
+            {
+                out.push_back(LayoutPlacement{node.name, WindowSpec(height, width, top, left)});
+                return;
+            }
+
+            bool horizontal = node.kind == LayoutNode::Kind::Row;
+            int total = horizontal ? width : height;
+            std::vector<int> sizes = distribute(node.children, total);
+
+            int offset = 0;
+            for (size_t i = 0; i < node.children.size(); ++i)
+            {
+                int size = std::clamp(sizes[i], 0, std::max(total - offset, 0));
+                if (horizontal) place(node.children[i], top, left + offset, height, size, out);
+                else place(node.children[i], top + offset, left, size, width, out);
+                offset += size;
+            }
+        }
+
+        static int clampToBounds(int cells, const LayoutSize& size)
+        {
+            cells = std::max(cells, size.min);
+            if (size.max >= 0) cells = std::min(cells, size.max);
+            return std::max(cells, 0);
+        }
+
+        /**
+         * Split `total` cells between children along the main axis. Fixed children are served
+         * first (in order, as far as space allows); flexible children share the rest by weight.
+         * A flexible child whose share falls outside its min/max is pinned to the bound and the
+         * remainder re-shared among the others. Fractions are rounded by largest remainder so the
+         * sizes always add up to the space available.
+         */
+        static std::vector<int> distribute(const std::vector<LayoutNode>& children, int total)
+        {
+            std::vector<int> sizes(children.size(), 0);
+            int remaining = total;
+
+            std::vector<size_t> flexible;
+            for (size_t i = 0; i < children.size(); ++i)
+            {
+                const LayoutSize& size = children[i].size;
+                if (size.fixed < 0)
+                {
+                    flexible.push_back(i);
+                    continue;
+                }
+                sizes[i] = std::min(clampToBounds(size.fixed, size), std::max(remaining, 0));
+                remaining -= sizes[i];
+            }
+
+            std::vector<bool> pinned(children.size(), false);
+            bool repinned = true;
+            while (repinned)
+            {
+                repinned = false;
+                double weightSum = 0.0;
+                int space = remaining;
+                for (size_t i : flexible)
+                {
+                    if (pinned[i]) space -= sizes[i];
+                    else weightSum += std::max(children[i].size.flex, 0.0);
+                }
+                if (weightSum <= 0.0) break;
+
+                for (size_t i : flexible)
+                {
+                    if (pinned[i]) continue;
+                    const LayoutSize& size = children[i].size;
+                    double share = std::max(space, 0) * std::max(size.flex, 0.0) / weightSum;
+                    if (share < size.min || (size.max >= 0 && share > size.max))
+                    {
+                        sizes[i] = clampToBounds(static_cast<int>(std::lround(share)), size);
+                        pinned[i] = true;
+                        repinned = true;
+                    }
+                }
+                if (repinned) continue;
+
+                // No bound violated: round the shares, largest remainders first
+                std::vector<std::pair<double, size_t>> remainders;
+                int assigned = 0;
+                for (size_t i : flexible)
+                {
+                    if (pinned[i]) continue;
+                    double share = std::max(space, 0) * std::max(children[i].size.flex, 0.0) / weightSum;
+                    sizes[i] = static_cast<int>(share);
+                    assigned += sizes[i];
+                    remainders.emplace_back(share - sizes[i], i);
+                }
+                std::stable_sort(remainders.begin(), remainders.end(),
+                                 [](const auto& a, const auto& b) { return a.first > b.first; });
+                for (size_t k = 0; k < remainders.size() && assigned < space; ++k, ++assigned)
+                {
+                    ++sizes[remainders[k].second];
+                }
+            }
+            return sizes;
+        }
+    };
+
+} // namespace stevensTerminal
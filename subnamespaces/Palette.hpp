@@ -0,0 +1,361 @@
+#pragma once
+/**
+ * @file Palette.hpp
+ * @brief Animated palette slots: fade and pulse colours without redrawing the cells that use them.
+ *
+ * An AnimatedPalette reserves a few colour slots. Each slot is a colour pair that text is drawn
+ * with (use()), and changing the slot's RGB value (set(), animate()) recolours every cell drawn
+ * with it. How that happens depends on the terminal:
+ *
+ * Palette — can_change_color(): each slot owns a spare colour number and init_color() redefines
+ *           it. The terminal recolours the cells itself; nothing is redrawn. (On xterm-like
+ *           terminals ncurses sends this as an OSC 4 sequence.)
+ * Pairs   — fixed colours but spare colour pairs: each slot owns a pair whose foreground is
+ *           re-pointed with init_pair() at the nearest named colour. curses repaints the cells
+ *           using the pair at the next refresh.
+ * Rewrite — neither: a slot draws with the library's pair for its nearest named colour, and when
+ *           that changes, the cells in the regions bound to the slot (bind()) are rewritten with
+ *           wchgat().
+ *
+ * Pairs and Rewrite quantize to the named colours, so a fade steps rather than glides, and they
+ * only touch the screen when the nearest colour actually changes.
+ *
+ * Usage:
+ *   stevensTerminal::AnimatedPalette palette;
+ *   int alert = palette.reserve({255, 64, 64});
+ *   palette.use(statusWin, alert);
+ *   mvwaddstr(statusWin, 0, 2, "LOW HEALTH");
+ *   palette.bind(alert, statusWin, 0, 2, 1, 10);   // only needed for the Rewrite fallback
+ *   palette.animate(stevensTerminal::animationTimers(), alert, {96, 0, 0}, 600,
+ *                   stevensTerminal::easing::inOutSine, stevensTerminal::TimerWheel::Repeat::PingPong);
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <iterator>
+#include <string>
+#include <vector>
+#include "Colors.hpp"
+#include "TimerWheel.hpp"
+
+#if defined(__linux__)
+    #include <ncurses.h>
+#elif defined(_WIN32) || defined(__MSDOS__)
+    #include <curses.h>
+#endif
+
+namespace stevensTerminal
+{
+    /**
+     * @brief An RGB colour, 0-255 per channel
+     */
+    struct Rgb
+    {
+        uint8_t r = 0;
+        uint8_t g = 0;
+        uint8_t b = 0;
+
+        bool operator==(const Rgb& other) const = default;
+
+        /** @brief Linear blend: t = 0 gives from, t = 1 gives to. */
+        static Rgb mix(Rgb from, Rgb to, float t)
+        {
+            auto channel = [t](uint8_t start, uint8_t end) {
+                return static_cast<uint8_t>(std::clamp(start + (end - start) * t + 0.5f, 0.0f, 255.0f));
+            };
+            return { channel(from.r, to.r), channel(from.g, to.g), channel(from.b, to.b) };
+        }
+    };
+
+    class AnimatedPalette
+    {
+    public:
+        enum class Mode { Palette, Pairs, Rewrite };
+
+        /**
+         * @brief Pick the best mode the terminal supports, no better than `limit`. Colours must
+         * already be initialized (start_color() and the library's colour pairs).
+         * @param slotCount Most slots reserve() will hand out
+         * @param limit     Best mode to use; lower it to force a fallback
+         */
+        explicit AnimatedPalette(int slotCount = 8, Mode limit = Mode::Palette)
+            : maxSlots(std::max(slotCount, 0))
+        {
+            const int colorCount = has_colors() ? COLORS : 0;
+            const int pairCount = has_colors() ? std::min(COLOR_PAIRS, 32767) : 0;
+            int libraryPairs = 1;
+            for (const auto& [name, pair] : Colors::curses_colorPairs) libraryPairs = std::max(libraryPairs, pair + 1);
+            const bool sparePairs = pairCount - libraryPairs >= maxSlots && maxSlots > 0;
+
+            if (limit == Mode::Palette && sparePairs && can_change_color() && colorCount - 16 >= maxSlots)
+                mode_ = Mode::Palette;
+            else if (limit != Mode::Rewrite && sparePairs)
+                mode_ = Mode::Pairs;
+            else
+                mode_ = Mode::Rewrite;
+
+            firstPair = libraryPairs;
+            lastPair = pairCount - 1;
+            lastColor = colorCount - 1;
+        }
+
+        ~AnimatedPalette()
+        {
+            for (Slot& slot : slots)
+            {
+                if (mode_ == Mode::Palette)
+                {
+                    init_color(slot.color, slot.original[0], slot.original[1], slot.original[2]);
+                    claims().colors.erase(std::find(claims().colors.begin(), claims().colors.end(), slot.color));
+                }
+                if (mode_ != Mode::Rewrite)
+                {
+                    claims().pairs.erase(std::find(claims().pairs.begin(), claims().pairs.end(), slot.pair));
+                }
+            }
+        }
+
+        AnimatedPalette(const AnimatedPalette&) = delete;
+        AnimatedPalette& operator=(const AnimatedPalette&) = delete;
+
+        Mode mode() const { return mode_; }
+
+        /**
+         * @brief Reserve a slot showing `color` on the named background colour
+         * @return The slot, or -1 if every slot is taken
+         */
+        int reserve(Rgb color, const std::string& bgColor = Colors::curses_default_backgroundColor)
+        {
+            if (static_cast<int>(slots.size()) >= maxSlots) return -1;
+
+            Slot slot;
+            slot.bgName = bgColor;
+            auto bg = Colors::curses_colors.find(bgColor);
+            slot.bg = static_cast<short>(bg != Colors::curses_colors.end() ? bg->second : COLOR_BLACK);
+
+            if (mode_ != Mode::Rewrite)
+            {
+                slot.pair = claim(claims().pairs, lastPair, firstPair);
+                if (slot.pair < 0) return -1;
+            }
+            if (mode_ == Mode::Palette)
+            {
+                slot.color = claim(claims().colors, lastColor, 16);
+                if (slot.color < 0)
+                {
+                    claims().pairs.erase(std::find(claims().pairs.begin(), claims().pairs.end(), slot.pair));
+                    return -1;
+                }
+                color_content(slot.color, &slot.original[0], &slot.original[1], &slot.original[2]);
+                init_pair(slot.pair, slot.color, slot.bg);
+            }
+
+            slot.rgb = color;
+            slots.push_back(slot);
+            apply(slots.back());
+            return static_cast<int>(slots.size()) - 1;
+        }
+
+        /**
+         * @brief Make `slot` the colour of text drawn in win from here on (wcolor_set()).
+         */
+        void use(WINDOW* win, int slot) const
+        {
+            if (!win || !valid(slot)) return;
+            wcolor_set(win, slots[slot].pair, nullptr);
+        }
+
+        /** @brief The colour pair drawing with `slot` currently uses. */
+        short pair(int slot) const { return valid(slot) ? slots[slot].pair : 0; }
+
+        /**
+         * @brief Register cells drawn with `slot`, for the Rewrite fallback to recolour when the
+         * slot changes. Other modes ignore it.
+         */
+        void bind(int slot, WINDOW* win, int y, int x, int rows, int cols)
+        {
+            if (!valid(slot) || !win || rows <= 0 || cols <= 0) return;
+            slots[slot].regions.push_back({ win, y, x, rows, cols });
+        }
+
+        /** @brief Forget every region bound in win, e.g. before deleting it. */
+        void unbind(WINDOW* win)
+        {
+            for (Slot& slot : slots)
+            {
+                std::erase_if(slot.regions, [win](const Region& region) { return region.win == win; });
+            }
+        }
+
+        /**
+         * @brief Change a slot's colour. Cells drawn with it follow at the next refresh.
+         */
+        void set(int slot, Rgb color)
+        {
+            if (!valid(slot)) return;
+            if (slots[slot].rgb == color) return;
+            slots[slot].rgb = color;
+            apply(slots[slot]);
+        }
+
+        Rgb color(int slot) const { return valid(slot) ? slots[slot].rgb : Rgb{}; }
+
+        /**
+         * @brief Tween a slot from its current colour to `to` on a TimerWheel. The palette must
+         * outlive the tween; cancel the returned id to stop it early.
+         */
+        TimerWheel::Id animate(TimerWheel& timers, int slot, Rgb to, uint64_t durationMs,
+                               easing::Curve curve = easing::inOutSine,
+                               TimerWheel::Repeat repeat = TimerWheel::Repeat::None)
+        {
+            const Rgb from = color(slot);
+            return timers.tween(durationMs, curve, [this, slot, from, to](float t) {
+                set(slot, Rgb::mix(from, to, t));
+            }, repeat);
+        }
+
+        /** @brief Cells rewritten by the Rewrite fallback so far. */
+        size_t cellsRewritten() const { return rewritten; }
+
+    private:
+        struct Region
+        {
+            WINDOW* win;
+            int     y, x, rows, cols;
+        };
+
+        struct Slot
+        {
+            short               pair = 0;
+            short               color = -1;          // Palette mode only
+            short               bg = 0;
+            short               original[3] = {};    // the colour's RGB before it was reserved
+            std::string         bgName;
+            std::string         nearest;             // named colour shown (Pairs / Rewrite)
+            Rgb                 rgb;
+            std::vector<Region> regions;
+        };
+
+        // Colour and pair numbers held by every live palette
+        struct Claims
+        {
+            std::vector<short> colors;
+            std::vector<short> pairs;
+        };
+
+        static Claims& claims()
+        {
+            static Claims held;
+            return held;
+        }
+
+        Mode              mode_ = Mode::Rewrite;
+        int               maxSlots;
+        int               firstPair = 1, lastPair = 0, lastColor = 0;
+        std::vector<Slot> slots;
+        size_t            rewritten = 0;
+
+        bool valid(int slot) const { return slot >= 0 && slot < static_cast<int>(slots.size()); }
+
+        /** Push the slot's rgb to the terminal the way the mode does it. */
+        void apply(Slot& slot)
+        {
+            if (mode_ == Mode::Palette)
+            {
+                init_color(slot.color, toCurses(slot.rgb.r), toCurses(slot.rgb.g), toCurses(slot.rgb.b));
+                return;
+            }
+
+            std::string name = nearestNamed(slot.rgb);
+            if (name.empty() || name == slot.nearest) return;
+            slot.nearest = std::move(name);
+            if (mode_ == Mode::Pairs)
+            {
+                init_pair(slot.pair, static_cast<short>(Colors::curses_colors.at(slot.nearest)), slot.bg);
+                return;
+            }
+
+            const short previous = slot.pair;
+            slot.pair = static_cast<short>(Colors::lookupColorPairByName(slot.nearest, slot.bgName));
+            if (previous != slot.pair) rewrite(slot, previous);
+        }
+
+        /** Highest number in [low, high] nobody holds, or -1. */
+        static short claim(std::vector<short>& held, int high, int low)
+        {
+            for (int n = high; n >= low; --n)
+            {
+                if (std::find(held.begin(), held.end(), n) != held.end()) continue;
+                held.push_back(static_cast<short>(n));
+                return static_cast<short>(n);
+            }
+            return -1;
+        }
+
+        static short toCurses(uint8_t channel) { return static_cast<short>(channel * 1000 / 255); }
+
+        /** The library colour name closest to color (squared RGB distance). */
+        static std::string nearestNamed(Rgb color)
+        {
+            struct Named { const char* name; Rgb rgb; };
+            static const Named table[] = {
+                { "black",        {   0,   0,   0 } }, { "red",            { 205,   0,   0 } },
+                { "green",        {   0, 205,   0 } }, { "yellow",         { 205, 205,   0 } },
+                { "blue",         {   0,   0, 238 } }, { "magenta",        { 205,   0, 205 } },
+                { "cyan",         {   0, 205, 205 } }, { "white",          { 229, 229, 229 } },
+                { "bright-black", { 127, 127, 127 } }, { "bright-red",     { 255,   0,   0 } },
+                { "bright-green", {   0, 255,   0 } }, { "bright-yellow",  { 255, 255,   0 } },
+                { "bright-blue",  {  92,  92, 255 } }, { "bright-magenta", { 255,   0, 255 } },
+                { "bright-cyan",  {   0, 255, 255 } }, { "bright-white",   { 255, 255, 255 } },
+            };
+            int best = -1;
+            long bestDistance = 0;
+            for (size_t i = 0; i < std::size(table); ++i)
+            {
+                if (!Colors::curses_colors.contains(table[i].name)) continue;
+                const long dr = color.r - table[i].rgb.r, dg = color.g - table[i].rgb.g, db = color.b - table[i].rgb.b;
+                const long distance = dr * dr + dg * dg + db * db;
+                if (best < 0 || distance < bestDistance)
+                {
+                    best = static_cast<int>(i);
+                    bestDistance = distance;
+                }
+            }
+            return best < 0 ? std::string() : std::string(table[best].name);
+        }
+
+        /** Re-pair the cells in the slot's regions that were drawn with `previous`. */
+        void rewrite(const Slot& slot, short previous)
+        {
+            std::vector<chtype> cells;
+            for (const Region& region : slot.regions)
+            {
+                int cursorY, cursorX;
+                getyx(region.win, cursorY, cursorX);
+                cells.resize(static_cast<size_t>(region.cols) + 1);
+                for (int row = region.y; row < region.y + region.rows; ++row)
+                {
+                    const int count = mvwinchnstr(region.win, row, region.x, cells.data(), region.cols);
+                    // Runs of same-attribute cells in the old pair become one wchgat() each
+                    for (int col = 0; col < count; )
+                    {
+                        if (PAIR_NUMBER(cells[col]) != previous)
+                        {
+                            ++col;
+                            continue;
+                        }
+                        const attr_t attrs = cells[col] & A_ATTRIBUTES & ~A_COLOR;
+                        int end = col + 1;
+                        while (end < count && PAIR_NUMBER(cells[end]) == previous
+                               && (cells[end] & A_ATTRIBUTES & ~A_COLOR) == attrs) ++end;
+                        mvwchgat(region.win, row, region.x + col, end - col, attrs, slot.pair, nullptr);
+                        rewritten += static_cast<size_t>(end - col);
+                        col = end;
+                    }
+                }
+                wmove(region.win, cursorY, cursorX);
+            }
+        }
+    };
+
+} // namespace stevensTerminal
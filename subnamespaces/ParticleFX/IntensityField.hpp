@@ -0,0 +1,144 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stevensTerminal {
+namespace ParticleFX {
+
+/**
+ * @brief One step of a trail's colour ramp, from faintest to brightest
+ */
+struct TrailStep {
+    chtype glyph = ' ';   // 0 keeps the window's own character and only recolours it
+    int colorPair = 0;
+};
+
+/**
+ * @brief A window-sized grid of decaying intensities in [0, 1], for particle trails.
+ *
+ * Particles deposit intensity into the cell under them, decay() fades every cell by the same
+ * factor, and diff() quantizes the grid to ramp levels and reports only the cells whose level
+ * changed since the last diff(). A frame therefore costs O(window area) however many
+ * particles there are, and the terminal only sees the cells that actually changed. Pure
+ * data - no curses calls.
+ */
+class IntensityField {
+public:
+    static constexpr uint8_t Unknown = 0xFF;   // shown level for cells that must be redrawn
+
+    /**
+     * @brief Size the field for a rows x cols area, clearing it. Nothing counts as drawn.
+     */
+    void resize(int rowCount, int colCount) {
+        rows = std::max(rowCount, 0);
+        cols = std::max(colCount, 0);
+        values.assign(static_cast<size_t>(rows) * cols, 0.0f);
+        shown.assign(values.size(), 0);
+        lit = 0;
+    }
+
+    int rowCount() const { return rows; }
+    int colCount() const { return cols; }
+
+    /**
+     * @brief Zero every cell. Cells already drawn are still reported by the next diff().
+     */
+    void clear() {
+        std::fill(values.begin(), values.end(), 0.0f);
+        lit = 0;
+    }
+
+    /**
+     * @brief Add intensity to the cell under (x, y), saturating at 1
+     */
+    void deposit(float x, float y, float amount) {
+        int col = static_cast<int>(std::round(x));
+        int row = static_cast<int>(std::round(y));
+        if (col < 0 || row < 0 || col >= cols || row >= rows) return;
+        float& value = values[static_cast<size_t>(row) * cols + col];
+        if (value == 0.0f && amount > 0.0f) ++lit;
+        value = std::min(value + amount, 1.0f);
+    }
+
+    /**
+     * @brief Multiply every cell by factor, zeroing cells that fall below cutoff
+     * @return Number of cells still lit
+     */
+    size_t decay(float factor, float cutoff = 1.0f / 256.0f) {
+        float* __restrict v = values.data();
+        const size_t count = values.size();
+        size_t stillLit = 0;
+        for (size_t i = 0; i < count; ++i) {
+            float faded = v[i] * factor;
+            bool keep = faded >= cutoff;
+            v[i] = keep ? faded : 0.0f;
+            stillLit += keep;
+        }
+        lit = stillLit;
+        return lit;
+    }
+
+    /** @brief Cells with any intensity left */
+    size_t litCount() const { return lit; }
+
+    float intensity(int row, int col) const {
+        return values[static_cast<size_t>(row) * cols + col];
+    }
+
+    /**
+     * @brief Ramp level for an intensity: 0 (nothing drawn) up to levels
+     */
+    static uint8_t quantize(float value, size_t levels) {
+        float scaled = value * static_cast<float>(levels) + 0.5f;
+        return static_cast<uint8_t>(std::min(static_cast<size_t>(scaled), levels));
+    }
+
+    /**
+     * @brief Quantize every cell to [0, levels] and call changed(row, col, level) for each
+     * cell whose level differs from what the last diff() reported (or that was invalidated)
+     * @return Number of cells reported
+     */
+    template <typename Changed>
+    size_t diff(size_t levels, Changed&& changed) {
+        levels = std::min<size_t>(levels, Unknown - 1);
+        size_t reported = 0;
+        for (int row = 0; row < rows; ++row) {
+            const size_t base = static_cast<size_t>(row) * cols;
+            for (int col = 0; col < cols; ++col) {
+                uint8_t level = quantize(values[base + col], levels);
+                if (level == shown[base + col]) continue;
+                shown[base + col] = level;
+                changed(row, col, level);
+                ++reported;
+            }
+        }
+        return reported;
+    }
+
+    /**
+     * @brief Make the next diff() report this cell if the trail is showing there, e.g. after
+     * something else drew over it
+     */
+    void invalidate(int row, int col) {
+        if (col < 0 || row < 0 || col >= cols || row >= rows) return;
+        uint8_t& level = shown[static_cast<size_t>(row) * cols + col];
+        if (level != 0) level = Unknown;
+    }
+
+    void invalidateAll() {
+        std::fill(shown.begin(), shown.end(), Unknown);
+    }
+
+private:
+    int rows = 0, cols = 0;
+    std::vector<float> values;
+    std::vector<uint8_t> shown;   // level last reported by diff()
+    size_t lit = 0;
+};
+
+} // namespace ParticleFX
+} // namespace stevensTerminal
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <bit>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stevensTerminal {
+namespace ParticleFX {
+
+/**
+ * @brief One bit per window cell, set where the window shows something other than a blank.
+ *
+ * Rows are packed into 64-bit words, so an 80x24 window fits in 48 words and a lookup is a
+ * shift and a mask. Particles use it to collide with text and borders.
+ */
+class OccupancyMap {
+public:
+    /**
+     * @brief Rebuild from a row-major rows x cols array of cells
+     */
+    void build(int rowCount, int colCount, const chtype* cells) {
+        rows = rowCount > 0 ? rowCount : 0;
+        cols = colCount > 0 ? colCount : 0;
+        wordsPerRow = (static_cast<size_t>(cols) + 63) / 64;
+        words.assign(wordsPerRow * rows, 0);
+        for (int row = 0; row < rows; ++row) {
+            uint64_t* rowWords = words.data() + row * wordsPerRow;
+            const chtype* rowCells = cells + static_cast<size_t>(row) * cols;
+            for (int col = 0; col < cols; ++col) {
+                chtype glyph = rowCells[col] & A_CHARTEXT;
+                uint64_t solid = (glyph != ' ' && glyph != 0) ? 1 : 0;
+                rowWords[col >> 6] |= solid << (col & 63);
+            }
+        }
+    }
+
+    int rowCount() const { return rows; }
+    int colCount() const { return cols; }
+
+    /**
+     * @brief True if (row, col) is inside the map and non-blank
+     */
+    bool occupied(int row, int col) const {
+        if (row < 0 || col < 0 || row >= rows || col >= cols) return false;
+        return (words[row * wordsPerRow + (col >> 6)] >> (col & 63)) & 1;
+    }
+
+    /**
+     * @brief occupied() for the cell a particle at (x, y) is drawn in. floor(v + 0.5) rounds
+     * like render()'s std::round() for every on-screen (non-negative) position, and inlines.
+     */
+    bool occupiedAt(float x, float y) const {
+        return occupied(static_cast<int>(std::floor(y + 0.5f)), static_cast<int>(std::floor(x + 0.5f)));
+    }
+
+    /**
+     * @brief Number of non-blank cells
+     */
+    size_t count() const {
+        size_t total = 0;
+        for (uint64_t word : words) total += static_cast<size_t>(std::popcount(word));
+        return total;
+    }
+
+private:
+    int rows = 0, cols = 0;
+    size_t wordsPerRow = 0;
+    std::vector<uint64_t> words;
+};
+
+} // namespace ParticleFX
+} // namespace stevensTerminal
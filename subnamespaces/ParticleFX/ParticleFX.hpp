@@ -36,7 +36,7 @@
  *       effect.render();                           // Particles first
  *       ParticleWindowRegistry::restoreWindow(window);  // Content on top
  *   } else {
- *       ParticleWindowRegistry::restoreWindow(window);  // Content first
+ *       ParticleWindowRegistry::restoreTouched(window); // Content first
  *       effect.render();                           // Particles on top (current)
  *   }
  *
@@ -52,11 +52,20 @@
 #include <chrono>
 #include <thread>
 #include <algorithm>
+#include <optional>
+#include <string>
+#include <stevensStringLib.h>
 
 // Include ParticleFX components
 #include "Vec2.hpp"
 #include "ParticlePhysics.hpp"
 #include "ParticleWindowRegistry.hpp"
+#include "ParticleStorage.hpp"
+#include "ParticleRandom.hpp"
+#include "SubCellGrid.hpp"
+#include "IntensityField.hpp"
+#include "../FrameScheduler.hpp"
+#include "../ThreadPool.hpp"
 
 namespace stevensTerminal {
 namespace ParticleFX {
@@ -125,6 +134,7 @@ public:
     // Getters
     Vec2 getPosition() const { return position; }
     Vec2 getVelocity() const { return velocity; }
+    const ParticlePhysics& getPhysics() const { return physics; }
     std::tuple<int, int> getRenderPosition() const {
         return {static_cast<int>(std::round(position.x)),
                 static_cast<int>(std::round(position.y))};
@@ -138,6 +148,16 @@ public:
     bool shouldModifyChar() const { return modifyChar; }
     int getLayer() const { return layer; }
 
+    /**
+     * @brief True if both particles move and draw the same way, i.e. can share one group
+     */
+    bool sharesGroupWith(const Particle& other) const {
+        return physics == other.physics && colorPair == other.colorPair &&
+               character == other.character && modifyBg == other.modifyBg &&
+               modifyFg == other.modifyFg && modifyChar == other.modifyChar &&
+               layer == other.layer;
+    }
+
     bool isAlive() const { return age < lifetime; }
     float getLifePercent() const { return lifetime > 0.0f ? age / lifetime : 1.0f; }
 
@@ -196,6 +216,162 @@ public:
     }
 };
 
+/**
+ * @brief Continuous particle source: spawns particles at a steady rate from a shape
+ *
+ * Rates are fractional-accumulated, so 30 particles/s at 60 fps spawns one every other frame
+ * rather than rounding to zero or one every frame. Spawned particles go into the owning
+ * ParticleEffect's pooled storage, so a steady stream (snow, embers, smoke) runs at constant
+ * memory once the pool has grown to rate x lifetime.
+ *
+ * Usage:
+ *   ParticleEmitter snow = ParticleEmitter::rect(0, 0, 80, 1);
+ *   snow.setPrototype(snowflake);
+ *   snow.setRate(40.0f);
+ *   snow.setDirection(std::numbers::pi_v<float> / 2, 0.4f);   // downward, slightly spread
+ *   snow.setSpeedRange(1.0f, 3.0f);
+ *   effect.addEmitter(snow);                                  // effect.update() now spawns too
+ */
+class ParticleEmitter {
+public:
+    enum class Shape {
+        Point,     // every particle starts at one point
+        Line,      // anywhere on a segment
+        Rect,      // anywhere inside a rectangle
+        TextMask   // on a random non-space character of a string
+    };
+
+    static ParticleEmitter point(Vec2 position) {
+        ParticleEmitter emitter(Shape::Point);
+        emitter.origin = position;
+        return emitter;
+    }
+
+    static ParticleEmitter line(Vec2 start, Vec2 end) {
+        ParticleEmitter emitter(Shape::Line);
+        emitter.origin = start;
+        emitter.extent = end - start;
+        return emitter;
+    }
+
+    static ParticleEmitter rect(float x, float y, float width, float height) {
+        ParticleEmitter emitter(Shape::Rect);
+        emitter.origin = Vec2(x, y);
+        emitter.extent = Vec2(width, height);
+        return emitter;
+    }
+
+    /**
+     * @brief Spawn on the non-space characters of text as printed at (startY, startX)
+     *
+     * The text is UTF-8: each codepoint is one mask point and moves x on by its display width,
+     * as curses does when printing it (wide glyphs take two cells, combining marks none).
+     */
+    static ParticleEmitter textMask(const std::string& text, int startY, int startX) {
+        ParticleEmitter emitter(Shape::TextMask);
+        int x = startX;
+        int y = startY;
+        for (size_t i = 0; i < text.size(); ) {
+            unsigned char lead = static_cast<unsigned char>(text[i]);
+            if (lead == '\n') {
+                ++y;
+                x = startX;
+                ++i;
+                continue;
+            }
+            if (lead < 0x80) {
+                if (lead != ' ') emitter.maskPoints.push_back(Vec2(x, y));
+                ++x;
+                ++i;
+                continue;
+            }
+            size_t length = (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3 : (lead & 0xF8) == 0xF0 ? 4 : 1;
+            length = std::min(length, text.size() - i);
+            int width = static_cast<int>(stevensStringLib::lineDisplayWidth(text.substr(i, length)));
+            if (width > 0) emitter.maskPoints.push_back(Vec2(x, y));
+            x += width;
+            i += length;
+        }
+        return emitter;
+    }
+
+    void setPrototype(const Particle& particle) { prototype = particle; }
+    void setRate(float particlesPerSecond) { rate = std::max(particlesPerSecond, 0.0f); }
+
+    /**
+     * @brief Launch angles are drawn from [angle - spread/2, angle + spread/2], in radians
+     *        (0 = right, pi/2 = down). The default is every direction.
+     */
+    void setDirection(float angle, float spread) {
+        minAngle = angle - spread / 2;
+        maxAngle = angle + spread / 2;
+    }
+
+    void setSpeedRange(float min, float max) {
+        minSpeed = min;
+        maxSpeed = max;
+    }
+
+    /**
+     * @brief Pause or resume spawning. Particles already spawned live out their lifetimes.
+     */
+    void setActive(bool active) { this->active = active; }
+
+    const Particle& getPrototype() const { return prototype; }
+    float getRate() const { return rate; }
+    bool isActive() const { return active; }
+    Shape getShape() const { return shape; }
+    float getMinAngle() const { return minAngle; }
+    float getMaxAngle() const { return maxAngle; }
+    float getMinSpeed() const { return minSpeed; }
+    float getMaxSpeed() const { return maxSpeed; }
+
+    /**
+     * @brief Advance the spawn clock by deltaTime
+     * @return Whole particles now due; the fractional remainder carries over to the next call
+     */
+    size_t takeSpawnCount(float deltaTime) {
+        if (!active || (shape == Shape::TextMask && maskPoints.empty())) return 0;
+        accumulator += rate * deltaTime;
+        float due = std::floor(accumulator);
+        accumulator -= due;
+        return static_cast<size_t>(due);
+    }
+
+    /**
+     * @brief A random spawn position within the shape
+     */
+    Vec2 samplePosition(ParticleRng& rng) const {
+        switch (shape) {
+            case Shape::Line:
+                return origin + extent * rng.uniform();
+            case Shape::Rect:
+                return Vec2(origin.x + extent.x * rng.uniform(), origin.y + extent.y * rng.uniform());
+            case Shape::TextMask:
+                return maskPoints[rng.uniformInt(0, static_cast<int>(maskPoints.size()) - 1)];
+            case Shape::Point:
+            default:
+                return origin;
+        }
+    }
+
+private:
+    explicit ParticleEmitter(Shape shapeParam) : shape(shapeParam) {}
+
+    Shape shape;
+    Vec2 origin;
+    Vec2 extent;                  // Line: end - start; Rect: width, height
+    std::vector<Vec2> maskPoints; // TextMask
+    Particle prototype;
+    float rate = 10.0f;
+    float minAngle = 0.0f;
+    float maxAngle = 2.0f * std::numbers::pi_v<float>;
+    float minSpeed = 1.0f;
+    float maxSpeed = 3.0f;
+    float accumulator = 0.0f;
+    bool active = true;
+};
+
 /**
  * @brief High-level particle effect system
  *
@@ -204,12 +380,181 @@ public:
  */
 class ParticleEffect {
 private:
-    std::vector<Particle> particles;
+    /**
+     * Particles spawned from the same prototype share one group: its physics and appearance
+     * are stored once, and its particles' changing state lives in structure-of-arrays form.
+     */
+    struct ParticleGroup {
+        Particle prototype;
+        ParticleArrays particles;
+    };
+
+    // Groups are never freed while the effect lives: one whose particles have all died is
+    // handed to the next new prototype, pool capacity included.
+    std::vector<ParticleGroup> groups;
+    std::vector<size_t> renderOrder;   // group indices, kept ordered by layer as groups change
+    std::vector<float> noise;          // per-step turbulence scratch, reused
+    std::vector<ParticleEmitter> continuousEmitters;
+    SubCellGrid subCells;              // sub-cell render scratch, reused
+    RenderMode renderMode = RenderMode::Cell;
+    SubCellColor subCellColor = SubCellColor::Latest;
+    size_t cellsWritten = 0;
+    IntensityField trail;              // empty ramp = no trail
+    std::vector<TrailStep> trailRamp;
+    float trailHalfLife = 0.3f;
+    float trailDeposit = 0.5f;
+    bool collideWithContent = false;
     WINDOW* targetWindow;
-    std::mt19937 rng;
+    ParticleRng rng;
+
+    size_t liveParticles = 0;
+    size_t maxParticles = 0;     // 0 = unlimited
+
+    // Groups at least this large are stepped in chunks across the pool (nullptr = default pool)
+    static constexpr size_t updateChunkSize = 4096;
+    size_t parallelThreshold = 20000;
+    ThreadPool* pool = nullptr;
 
     int minX, maxX, minY, maxY;  // Window boundaries
 
+    /**
+     * @brief The group for particles like prototype. Reuses an emptied group if there's no
+     * matching one, and only creates a new one when every group is in use.
+     */
+    ParticleArrays& groupFor(const Particle& prototype) {
+        size_t spare = groups.size();
+        for (size_t i = 0; i < groups.size(); ++i) {
+            if (groups[i].prototype.sharesGroupWith(prototype)) return groups[i].particles;
+            if (spare == groups.size() && groups[i].particles.empty()) spare = i;
+        }
+
+        if (spare == groups.size()) {
+            groups.push_back({prototype, {}});
+        } else {
+            renderOrder.erase(std::find(renderOrder.begin(), renderOrder.end(), spare));
+            groups[spare].prototype = prototype;
+        }
+
+        // Insert after every group on the same or a lower layer
+        int layer = prototype.getLayer();
+        auto position = std::upper_bound(renderOrder.begin(), renderOrder.end(), layer,
+            [this](int value, size_t index) { return value < groups[index].prototype.getLayer(); });
+        renderOrder.insert(position, spare);
+        return groups[spare].particles;
+    }
+
+    /**
+     * @brief Claim up to `wanted` particles in one go from a group, honouring the particle
+     * limit. Age and lifetime are set from the prototype, position and velocity from
+     * position/velocity; the caller overwrites whatever else it randomizes.
+     * @return Index of the first new particle and how many were claimed
+     */
+    std::pair<size_t, size_t> spawnInto(ParticleArrays& particles, size_t wanted, const Particle& prototype,
+                                        Vec2 position, Vec2 velocity) {
+        if (maxParticles > 0) {
+            wanted = std::min(wanted, maxParticles - std::min(maxParticles, liveParticles));
+        }
+        size_t first = particles.claim(wanted);
+        size_t end = first + wanted;
+        std::fill(particles.x.begin() + first, particles.x.begin() + end, position.x);
+        std::fill(particles.y.begin() + first, particles.y.begin() + end, position.y);
+        std::fill(particles.vx.begin() + first, particles.vx.begin() + end, velocity.x);
+        std::fill(particles.vy.begin() + first, particles.vy.begin() + end, velocity.y);
+        std::fill(particles.age.begin() + first, particles.age.begin() + end, prototype.getAge());
+        std::fill(particles.lifetime.begin() + first, particles.lifetime.begin() + end, prototype.getLifetime());
+        liveParticles += wanted;
+        return {first, wanted};
+    }
+
+    /**
+     * @brief Spawn what each continuous emitter has due, straight into its group's pool
+     */
+    void spawnFromEmitters(float deltaTime) {
+        for (ParticleEmitter& emitter : continuousEmitters) {
+            size_t due = emitter.takeSpawnCount(deltaTime);
+            if (due == 0) continue;
+            const Particle& prototype = emitter.getPrototype();
+            ParticleArrays& particles = groupFor(prototype);
+            auto [first, spawned] = spawnInto(particles, due, prototype, Vec2(), Vec2());
+            for (size_t i = first; i < first + spawned; ++i) {
+                Vec2 position = emitter.samplePosition(rng);
+                particles.x[i] = position.x;
+                particles.y[i] = position.y;
+            }
+            randomizeVelocities(particles, first, spawned, emitter.getMinAngle(), emitter.getMaxAngle(),
+                                emitter.getMinSpeed(), emitter.getMaxSpeed());
+        }
+    }
+
+    /**
+     * @brief Give particles [first, first + count) random velocities: angle and speed drawn
+     * uniformly from the given ranges
+     */
+    void randomizeVelocities(ParticleArrays& particles, size_t first, size_t count,
+                             float minAngle, float maxAngle, float minSpeed, float maxSpeed) {
+        for (size_t i = first; i < first + count; ++i) {
+            float angle = rng.uniform(minAngle, maxAngle);
+            float speed = rng.uniform(minSpeed, maxSpeed);
+            particles.vx[i] = std::cos(angle) * speed;
+            particles.vy[i] = std::sin(angle) * speed;
+        }
+    }
+
+    /**
+     * @brief Sub-cell render: plot every particle into the dot grid (lowest layer first, so
+     * with SubCellColor::Latest the top layer's colour wins), then write each covered cell once
+     */
+    void renderSubCells() {
+        subCells.reset(renderMode, maxY - minY, maxX - minX, subCellColor);
+        for (size_t groupIndex : renderOrder) {
+            const ParticleArrays& particles = groups[groupIndex].particles;
+            if (particles.empty()) continue;
+            int colorPair = groups[groupIndex].prototype.getColorPair();
+            for (size_t i = 0; i < particles.size(); ++i) {
+                subCells.plot(particles.x[i] - minX, particles.y[i] - minY, colorPair);
+            }
+        }
+
+        char glyph[4];
+        const int cols = subCells.colCount();
+        for (uint32_t index : subCells.coveredCells()) {
+            int y = minY + static_cast<int>(index / cols);
+            int x = minX + static_cast<int>(index % cols);
+            ParticleWindowRegistry::markTouched(targetWindow, y, x);
+            if (!trailRamp.empty()) trail.invalidate(y - minY, x - minX);
+            subCells.glyph(index, glyph);
+            int colorPair = subCells.colorPair(index);
+            wattron(targetWindow, COLOR_PAIR(colorPair));
+            mvwaddstr(targetWindow, y, x, glyph);
+            wattroff(targetWindow, COLOR_PAIR(colorPair));
+        }
+        cellsWritten += subCells.coveredCells().size();
+    }
+
+    /**
+     * @brief Redraw the trail cells whose ramp level changed. Trail cells aren't marked
+     * touched - they persist between frames - so a cell that fades out is put back from the
+     * window snapshot here, and one a particle drew over is redrawn after it's restored.
+     */
+    void renderTrail() {
+        cellsWritten += trail.diff(trailRamp.size(), [this](int row, int col, uint8_t level) {
+            int y = minY + row;
+            int x = minX + col;
+            if (level == 0) {
+                if (!ParticleWindowRegistry::restoreCell(targetWindow, y, x)) mvwaddch(targetWindow, y, x, ' ');
+                return;
+            }
+            const TrailStep& step = trailRamp[level - 1];
+            chtype glyph = step.glyph;
+            if (glyph == 0) {
+                chtype existingCell;
+                if (!ParticleWindowRegistry::snapshotCell(targetWindow, y, x, existingCell)) existingCell = ' ';
+                glyph = existingCell & A_CHARTEXT;
+            }
+            mvwaddch(targetWindow, y, x, glyph | COLOR_PAIR(step.colorPair));
+        });
+    }
+
     // Spawn configuration
     std::vector<Vec2> spawnPoints;
     int particlesPerPoint;
@@ -217,9 +562,14 @@ private:
     float maxSpeed;
 
 public:
-    ParticleEffect(WINDOW* window = nullptr)
+    /**
+     * @param window The window to render particles on
+     * @param seed   Seed for spawn directions, speeds and turbulence. Effects with the same seed,
+     *               spawns and time steps replay identically. Without one, a random seed is used.
+     */
+    ParticleEffect(WINDOW* window = nullptr, std::optional<uint64_t> seed = std::nullopt)
         : targetWindow(window)
-        , rng(std::random_device{}())
+        , rng(seed ? ParticleRng(*seed) : ParticleRng::fromRandomDevice())
         , minX(0), maxX(80), minY(0), maxY(24)
         , particlesPerPoint(3)
         , minSpeed(5.0f)
@@ -230,6 +580,13 @@ public:
         }
     }
 
+    /**
+     * @brief Restart the effect's random sequence, e.g. before replaying a recorded run
+     */
+    void setSeed(uint64_t seed) {
+        rng.seed(seed);
+    }
+
     /**
      * @brief Set the target window for particle rendering
      */
@@ -238,6 +595,8 @@ public:
         updateBoundaries();
     }
 
+    WINDOW* getWindow() const { return targetWindow; }
+
     /**
      * @brief Update window boundaries from current window size
      */
@@ -247,6 +606,9 @@ public:
             minX = 0;
             minY = 0;
         }
+        if (!trailRamp.empty() && (trail.rowCount() != maxY - minY || trail.colCount() != maxX - minX)) {
+            trail.resize(maxY - minY, maxX - minX);
+        }
     }
 
     /**
@@ -254,20 +616,182 @@ public:
      * @param deltaTime Time elapsed since last update (in seconds)
      */
     void update(float deltaTime) {
-        // Update all particles
-        for (auto& particle : particles) {
-            particle.update(deltaTime, rng);
-            particle.handleBoundaries(minX, maxX, minY, maxY);
+        spawnFromEmitters(deltaTime);
+
+        ParticleBounds bounds{static_cast<float>(minX), static_cast<float>(maxX),
+                              static_cast<float>(minY), static_cast<float>(maxY)};
+        const OccupancyMap* obstacles = (collideWithContent && targetWindow)
+                                      ? ParticleWindowRegistry::occupancy(targetWindow) : nullptr;
+
+        for (ParticleGroup& group : groups) {
+            ParticleArrays& particles = group.particles;
+            size_t count = particles.size();
+            if (count == 0) continue;
+
+            const ParticlePhysics& physics = group.prototype.getPhysics();
+            bool turbulent = physics.turbulence > 0.0f;
+            if (turbulent) noise.resize(2 * count);
+
+            // The group is stepped in fixed-size chunks, each drawing its turbulence up front
+            // (so the kernel stays branch-free) from its own random stream. A chunk's result
+            // doesn't depend on which thread runs it, so a seeded effect replays identically
+            // whether or not - and on however many threads - it was split up.
+            uint64_t stepSeed = turbulent ? (static_cast<uint64_t>(rng()) << 32) | rng() : 0;
+            size_t chunks = (count + updateChunkSize - 1) / updateChunkSize;
+            auto stepChunk = [&](size_t chunk) {
+                size_t begin = chunk * updateChunkSize;
+                size_t end = std::min(count, begin + updateChunkSize);
+                float* chunkNoise = nullptr;
+                if (turbulent) {
+                    chunkNoise = noise.data() + 2 * begin;
+                    ParticleRng::stream(stepSeed, chunk).fillUniform(chunkNoise, 2 * (end - begin),
+                                                                     -physics.turbulence, physics.turbulence);
+                }
+                ParticleKernels::integrate(particles, begin, end, physics, deltaTime, bounds, chunkNoise, obstacles);
+            };
+
+            if (chunks > 1 && count >= parallelThreshold) {
+                (pool ? *pool : defaultThreadPool()).parallelFor(chunks, stepChunk);
+            } else {
+                for (size_t chunk = 0; chunk < chunks; ++chunk) stepChunk(chunk);
+            }
+
+            // Compaction stays serial: it's a single cheap pass and reorders the arrays
+            liveParticles -= particles.removeDead();
+        }
+
+        if (!trailRamp.empty()) {
+            // Fade first so a particle's own cell stays at full strength this step
+            trail.decay(std::exp2(-deltaTime / trailHalfLife), 0.5f / trailRamp.size());
+            for (const ParticleGroup& group : groups) {
+                const ParticleArrays& particles = group.particles;
+                for (size_t i = 0; i < particles.size(); ++i) {
+                    trail.deposit(particles.x[i] - minX, particles.y[i] - minY, trailDeposit);
+                }
+            }
         }
+    }
+
+    // ========== Continuous Emitters ==========
+
+    /**
+     * @brief Add a continuous emitter; each update() spawns whatever particles it has due.
+     * Reserves pool room for its steady-state population (rate x lifetime) up front.
+     * @return Index for getEmitter()
+     */
+    size_t addEmitter(const ParticleEmitter& emitter) {
+        const Particle& prototype = emitter.getPrototype();
+        ParticleArrays& particles = groupFor(prototype);
+        float steadyState = emitter.getRate() * std::max(prototype.getLifetime() - prototype.getAge(), 0.0f);
+        particles.reserve(particles.size() + static_cast<size_t>(std::ceil(steadyState * 1.25f)) + 1);
+        continuousEmitters.push_back(emitter);
+        return continuousEmitters.size() - 1;
+    }
+
+    /**
+     * @brief A continuous emitter added with addEmitter(), e.g. to change its rate or pause it
+     */
+    ParticleEmitter& getEmitter(size_t index) {
+        return continuousEmitters.at(index);
+    }
+
+    size_t getEmitterCount() const {
+        return continuousEmitters.size();
+    }
+
+    /**
+     * @brief True if any continuous emitter is still spawning
+     */
+    bool hasActiveEmitters() const {
+        for (const ParticleEmitter& emitter : continuousEmitters) {
+            if (emitter.isActive()) return true;
+        }
+        return false;
+    }
+
+    void clearEmitters() {
+        continuousEmitters.clear();
+    }
 
-        // Remove dead particles
-        particles.erase(
-            std::remove_if(particles.begin(), particles.end(),
-                [](const Particle& p) { return !p.isAlive(); }),
-            particles.end()
-        );
+    /**
+     * @brief Bounce particles off the window's content - any non-blank cell of its
+     * ParticleWindowRegistry snapshot, text and borders alike - with their physics' bounce
+     * factor. Needs the window registered (EffectManager does that). Particles that start on
+     * a non-blank cell, e.g. spawned from text, move out of it freely.
+     */
+    void setContentCollision(bool enabled) {
+        collideWithContent = enabled;
+    }
+
+    /**
+     * @brief Step groups with at least this many particles on several threads. Smaller ones
+     * aren't worth the hand-off and stay on the calling thread.
+     * @param particles Threshold per group; SIZE_MAX keeps every update single-threaded
+     */
+    void setParallelThreshold(size_t particles) {
+        parallelThreshold = particles;
+    }
+
+    /**
+     * @brief Use this pool for parallel updates instead of defaultThreadPool()
+     */
+    void setThreadPool(ThreadPool& threadPool) {
+        pool = &threadPool;
+    }
+
+    /**
+     * @brief Draw particles as dots inside cells - 1x2 half blocks or 2x4 braille - instead of
+     * one character per particle. Several particles in a cell merge into one glyph, so each
+     * covered cell is written once. Particles take their colour pair's foreground; their
+     * character and modifyChar/modifyBg settings only apply in RenderMode::Cell.
+     * @param color Which colour a cell shared by differently coloured particles takes
+     */
+    void setRenderMode(RenderMode mode, SubCellColor color = SubCellColor::Latest) {
+        renderMode = mode;
+        subCellColor = color;
+    }
+
+    RenderMode getRenderMode() const { return renderMode; }
+
+    /**
+     * @brief Leave a fading trail: every update() each particle adds `deposit` intensity to
+     * its cell, intensities halve every `halfLife` seconds, and cells are drawn with the ramp
+     * step for their intensity (the first step faintest, the last at full intensity). Only
+     * cells whose step changed are rewritten, so a trail costs O(window area) per frame
+     * however many particles feed it. Trails persist across EffectManager's restore of touched
+     * cells; restoring the whole window each frame erases them.
+     * @param ramp Steps from faint to bright; empty turns the trail off
+     */
+    void setTrail(std::vector<TrailStep> ramp, float halfLife = 0.3f, float deposit = 0.5f) {
+        eraseTrail();
+        trailRamp = std::move(ramp);
+        trailHalfLife = std::max(halfLife, 1e-3f);
+        trailDeposit = deposit;
+        trail.resize(trailRamp.empty() ? 0 : maxY - minY, maxX - minX);
+    }
+
+    /**
+     * @brief True while any trail cell is still visible
+     */
+    bool hasVisibleTrail() const {
+        return !trailRamp.empty() && trail.litCount() > 0;
+    }
+
+    /**
+     * @brief Clear the trail now, putting the cells it covered back from the window snapshot.
+     * The trail stays enabled.
+     */
+    void eraseTrail() {
+        if (trailRamp.empty()) return;
+        trail.clear();
+        if (targetWindow) renderTrail();
     }
 
+    /**
+     * @brief Cells the last render() wrote to
+     */
+    size_t getCellsWritten() const { return cellsWritten; }
+
     /**
      * @brief Render all particles to the target window and stage it for screen update
      *
@@ -277,44 +801,60 @@ public:
      */
     void render() {
         if (!targetWindow) return;
+        cellsWritten = 0;
+        if (!trailRamp.empty()) renderTrail();
 
-        // Sort by layer (lower layers drawn first)
-        std::sort(particles.begin(), particles.end(),
-            [](const Particle& a, const Particle& b) {
-                return a.getLayer() < b.getLayer();
-            });
-
-        for (const auto& particle : particles) {
-            auto [x, y] = particle.getRenderPosition();
-
-            // Bounds check
-            if (x < minX || x >= maxX || y < minY || y >= maxY) continue;
-
-            // Read what's currently at this position
-            chtype existingCell = mvwinch(targetWindow, y, x);
-            char currentChar = existingCell & A_CHARTEXT;
-
-            // Determine what to modify based on particle settings
-            if (particle.shouldModifyChar()) {
-                // Particle wants to replace the character completely
-                wattron(targetWindow, COLOR_PAIR(particle.getColorPair()));
-                mvwaddch(targetWindow, y, x, particle.getCharacter());
-                wattroff(targetWindow, COLOR_PAIR(particle.getColorPair()));
-            }
-            else if (particle.shouldModifyBg()) {
-                // Particle wants to change background color only
-                // Preserve the existing foreground color and character, but use particle's background
-
-                int existingPair = PAIR_NUMBER(existingCell);
-                short existingFg = stevensTerminal::Colors::extractForegroundColor(existingPair);
-                short particleBg = stevensTerminal::Colors::extractBackgroundColor(particle.getColorPair());
-
-                // Combine existing fg with particle bg to preserve text visibility
-                int combinedPair = stevensTerminal::Colors::lookupColorPair(existingFg, particleBg);
+        if (renderMode != RenderMode::Cell) {
+            renderSubCells();
+            wnoutrefresh(targetWindow);
+            return;
+        }
 
-                wattron(targetWindow, COLOR_PAIR(combinedPair));
-                mvwaddch(targetWindow, y, x, currentChar);
-                wattroff(targetWindow, COLOR_PAIR(combinedPair));
+        // Groups are drawn lowest layer first
+        for (size_t groupIndex : renderOrder) {
+            const Particle& particle = groups[groupIndex].prototype;
+            const ParticleArrays& particles = groups[groupIndex].particles;
+            if (particles.empty()) continue;
+            if (!particle.shouldModifyChar() && !particle.shouldModifyBg()) continue;
+            short particleBg = stevensTerminal::Colors::extractBackgroundColor(particle.getColorPair());
+
+            for (size_t i = 0; i < particles.size(); ++i) {
+                int x = static_cast<int>(std::round(particles.x[i]));
+                int y = static_cast<int>(std::round(particles.y[i]));
+
+                // Bounds check
+                if (x < minX || x >= maxX || y < minY || y >= maxY) continue;
+                ParticleWindowRegistry::markTouched(targetWindow, y, x);
+                if (!trailRamp.empty()) trail.invalidate(y - minY, x - minX);
+                ++cellsWritten;
+
+                // Determine what to modify based on particle settings
+                if (particle.shouldModifyChar()) {
+                    // Particle wants to replace the character completely
+                    wattron(targetWindow, COLOR_PAIR(particle.getColorPair()));
+                    mvwaddch(targetWindow, y, x, particle.getCharacter());
+                    wattroff(targetWindow, COLOR_PAIR(particle.getColorPair()));
+                }
+                else {
+                    // Particle wants to change background color only
+                    // Preserve the existing foreground color and character, but use particle's background.
+                    // The content underneath comes from the registry's snapshot cache when there is one.
+                    chtype existingCell;
+                    if (!ParticleWindowRegistry::snapshotCell(targetWindow, y, x, existingCell)) {
+                        existingCell = mvwinch(targetWindow, y, x);
+                    }
+                    char currentChar = existingCell & A_CHARTEXT;
+
+                    int existingPair = PAIR_NUMBER(existingCell);
+                    short existingFg = stevensTerminal::Colors::extractForegroundColor(existingPair);
+
+                    // Combine existing fg with particle bg to preserve text visibility
+                    int combinedPair = stevensTerminal::Colors::lookupColorPair(existingFg, particleBg);
+
+                    wattron(targetWindow, COLOR_PAIR(combinedPair));
+                    mvwaddch(targetWindow, y, x, currentChar);
+                    wattroff(targetWindow, COLOR_PAIR(combinedPair));
+                }
             }
         }
 
@@ -386,20 +926,10 @@ public:
      * or addSpawnPointsFromText().
      */
     void spawn(const Particle& prototype) {
-        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * std::numbers::pi_v<float>);
-        std::uniform_real_distribution<float> speedDist(minSpeed, maxSpeed);
-
+        ParticleArrays& particles = groupFor(prototype);
         for (const Vec2& origin : spawnPoints) {
-            for (int i = 0; i < particlesPerPoint; ++i) {
-                float angle = angleDist(rng);
-                float speed = speedDist(rng);
-
-                Particle p = prototype;
-                p.setPosition(origin);
-                p.setVelocity(std::cos(angle) * speed, std::sin(angle) * speed);
-
-                particles.push_back(p);
-            }
+            auto [first, count] = spawnInto(particles, std::max(particlesPerPoint, 0), prototype, origin, Vec2());
+            randomizeVelocities(particles, first, count, 0.0f, 2.0f * std::numbers::pi_v<float>, minSpeed, maxSpeed);
         }
     }
 
@@ -415,19 +945,9 @@ public:
      */
     void spawnBurst(Vec2 origin, int count, const Particle& prototype,
                     float minSpeed = 5.0f, float maxSpeed = 15.0f) {
-        std::uniform_real_distribution<float> angleDist(0.0f, 2.0f * std::numbers::pi_v<float>);
-        std::uniform_real_distribution<float> speedDist(minSpeed, maxSpeed);
-
-        for (int i = 0; i < count; ++i) {
-            float angle = angleDist(rng);
-            float speed = speedDist(rng);
-
-            Particle p = prototype;
-            p.setPosition(origin);
-            p.setVelocity(std::cos(angle) * speed, std::sin(angle) * speed);
-
-            particles.push_back(p);
-        }
+        ParticleArrays& particles = groupFor(prototype);
+        auto [first, spawned] = spawnInto(particles, std::max(count, 0), prototype, origin, Vec2());
+        randomizeVelocities(particles, first, spawned, 0.0f, 2.0f * std::numbers::pi_v<float>, minSpeed, maxSpeed);
     }
 
     /**
@@ -441,19 +961,9 @@ public:
     void spawnFountain(Vec2 origin, int count, const Particle& prototype,
                        float angle = -std::numbers::pi_v<float>/2, float spread = std::numbers::pi_v<float>/6,
                        float minSpeed = 8.0f, float maxSpeed = 15.0f) {
-        std::uniform_real_distribution<float> angleDist(angle - spread/2, angle + spread/2);
-        std::uniform_real_distribution<float> speedDist(minSpeed, maxSpeed);
-
-        for (int i = 0; i < count; ++i) {
-            float particleAngle = angleDist(rng);
-            float speed = speedDist(rng);
-
-            Particle p = prototype;
-            p.setPosition(origin);
-            p.setVelocity(std::cos(particleAngle) * speed, std::sin(particleAngle) * speed);
-
-            particles.push_back(p);
-        }
+        ParticleArrays& particles = groupFor(prototype);
+        auto [first, spawned] = spawnInto(particles, std::max(count, 0), prototype, origin, Vec2());
+        randomizeVelocities(particles, first, spawned, angle - spread/2, angle + spread/2, minSpeed, maxSpeed);
     }
 
     /**
@@ -464,18 +974,11 @@ public:
      * @param prototype Particle template to copy
      */
     void spawnRain(int minXPos, int maxXPos, int count, const Particle& prototype) {
-        std::uniform_int_distribution<int> xDist(minXPos, maxXPos);
-        std::uniform_real_distribution<float> speedDist(2.0f, 5.0f);
-
-        for (int i = 0; i < count; ++i) {
-            int x = xDist(rng);
-            float speed = speedDist(rng);
-
-            Particle p = prototype;
-            p.setPosition(x, minY);
-            p.setVelocity(0, speed);
-
-            particles.push_back(p);
+        ParticleArrays& particles = groupFor(prototype);
+        auto [first, spawned] = spawnInto(particles, std::max(count, 0), prototype, Vec2(0, minY), Vec2());
+        for (size_t i = first; i < first + spawned; ++i) {
+            particles.x[i] = static_cast<float>(rng.uniformInt(minXPos, maxXPos));
+            particles.vy[i] = rng.uniform(2.0f, 5.0f);
         }
     }
 
@@ -487,14 +990,13 @@ public:
      * @param prototype Particle template to copy
      */
     void spawnLine(Vec2 start, Vec2 end, int count, const Particle& prototype) {
-        for (int i = 0; i < count; ++i) {
+        ParticleArrays& particles = groupFor(prototype);
+        auto [first, spawned] = spawnInto(particles, std::max(count, 0), prototype, start, prototype.getVelocity());
+        for (size_t i = 0; i < spawned; ++i) {
             float t = static_cast<float>(i) / (count - 1);
             Vec2 pos = start + (end - start) * t;
-
-            Particle p = prototype;
-            p.setPosition(pos);
-
-            particles.push_back(p);
+            particles.x[first + i] = pos.x;
+            particles.y[first + i] = pos.y;
         }
     }
 
@@ -502,21 +1004,202 @@ public:
      * @brief Add a single particle
      */
     void addParticle(const Particle& particle) {
-        particles.push_back(particle);
+        spawnInto(groupFor(particle), 1, particle, particle.getPosition(), particle.getVelocity());
     }
 
     /**
      * @brief Get current particle count
      */
     size_t getParticleCount() const {
-        return particles.size();
+        return liveParticles;
+    }
+
+    /**
+     * @brief Get number of groups (distinct particle prototypes) with live particles
+     */
+    size_t getGroupCount() const {
+        size_t count = 0;
+        for (const ParticleGroup& group : groups) count += group.particles.empty() ? 0 : 1;
+        return count;
+    }
+
+    /**
+     * @brief Limit how many particles can be alive at once; spawns beyond it are dropped.
+     * @param limit Maximum live particles, or 0 for no limit
+     */
+    void setMaxParticles(size_t limit) {
+        maxParticles = limit;
     }
 
     /**
-     * @brief Clear all particles
+     * @brief Preallocate room for this many particles like prototype, so a sustained effect
+     * never has to grow its pool mid-animation. (Until particles like prototype are spawned, the
+     * room may be handed to another prototype instead - it is never freed either way.)
+     */
+    void reserve(const Particle& prototype, size_t count) {
+        groupFor(prototype).reserve(count);
+    }
+
+    /**
+     * @brief Total particle slots allocated across all groups
+     */
+    size_t getCapacity() const {
+        size_t capacity = 0;
+        for (const ParticleGroup& group : groups) capacity += group.particles.capacity();
+        return capacity;
+    }
+
+    /**
+     * @brief Clear all particles (their storage is kept for reuse)
      */
     void clear() {
-        particles.clear();
+        for (ParticleGroup& group : groups) group.particles.clear();
+        liveParticles = 0;
+    }
+};
+
+/**
+ * @brief Runs any number of particle effects across windows without blocking the caller.
+ *
+ * The application's main loop calls tick() once per frame: every live effect is updated, the
+ * cells particles drew on last frame are restored, the effects are drawn, and one doupdate()
+ * pushes the frame. Finished effects are retired and their window snapshots released.
+ *
+ * Usage:
+ *   EffectManager effects;
+ *   ParticleEffect burst(statusWin);
+ *   burst.spawnBurst({10, 2}, 30, sparkPrototype);
+ *   effects.add(std::move(burst), 0.75f);
+ *   // main loop:
+ *   float dt = frames.beginFrame();
+ *   handleInput();
+ *   effects.tick(dt);
+ *   frames.endFrame();
+ */
+class EffectManager {
+public:
+    using EffectId = uint64_t;
+
+    EffectManager() = default;
+    EffectManager(const EffectManager&) = delete;
+    EffectManager& operator=(const EffectManager&) = delete;
+
+    ~EffectManager() { clear(); }
+
+    /**
+     * @brief Take over a configured effect and start animating it on the next tick()
+     * @param effect The effect; its window is registered for snapshot restoring now, so add it
+     *               before its particles have been drawn
+     * @param duration Seconds until the effect is retired, or 0 to retire it once its particles
+     *                 have all died, its continuous emitters have been paused and its trail
+     *                 has faded
+     * @return Id for get() and cancel()
+     */
+    EffectId add(ParticleEffect effect, float duration = 0.0f) {
+        if (WINDOW* window = effect.getWindow()) ParticleWindowRegistry::registerWindow(window);
+        EffectId id = nextId++;
+        entries.push_back({id, std::move(effect), duration, 0.0f, false});
+        return id;
+    }
+
+    /**
+     * @brief The live effect with this id (e.g. to spawn more particles into it), or nullptr
+     *
+     * Effects are stored by value in a vector, so the pointer is only valid until the next
+     * add(), tick() or clear() - look the effect up again by id rather than keeping it.
+     */
+    ParticleEffect* get(EffectId id) {
+        for (Entry& entry : entries) {
+            if (entry.id == id) return &entry.effect;
+        }
+        return nullptr;
+    }
+
+    /**
+     * @brief Retire an effect at the next tick()
+     */
+    void cancel(EffectId id) {
+        for (Entry& entry : entries) {
+            if (entry.id == id) entry.cancelled = true;
+        }
+    }
+
+    /**
+     * @brief Advance every effect by deltaTime, retire finished ones and draw the frame
+     *
+     * @param deltaTime Seconds since the last tick
+     * @param update Call doupdate() at the end. Pass false if the caller finishes the frame itself.
+     * @return Number of effects still running
+     */
+    size_t tick(float deltaTime, bool update = true) {
+        if (entries.empty()) return 0;
+
+        for (Entry& entry : entries) {
+            entry.elapsed += deltaTime;
+            bool timedOut = entry.duration > 0.0f && entry.elapsed >= entry.duration;
+            if (!entry.cancelled && !timedOut) entry.effect.update(deltaTime);
+            entry.finished = entry.cancelled || timedOut ||
+                             (entry.duration <= 0.0f && entry.effect.getParticleCount() == 0 &&
+                              !entry.effect.hasActiveEmitters() && !entry.effect.hasVisibleTrail());
+        }
+
+        // Undo last frame's particles once per window, then release finished effects' snapshots
+        windows.clear();
+        for (const Entry& entry : entries) {
+            WINDOW* window = entry.effect.getWindow();
+            if (window && std::find(windows.begin(), windows.end(), window) == windows.end()) {
+                windows.push_back(window);
+                ParticleWindowRegistry::restoreTouched(window);
+            }
+        }
+        retireFinished();
+
+        for (Entry& entry : entries) entry.effect.render();
+        for (WINDOW* window : windows) wnoutrefresh(window); // also covers windows with no effects left
+        if (update) doupdate();
+        return entries.size();
+    }
+
+    /**
+     * @brief Number of effects still running
+     */
+    size_t size() const { return entries.size(); }
+    bool empty() const { return entries.empty(); }
+
+    /**
+     * @brief Retire every effect now, restoring their windows (staged, not yet on screen)
+     */
+    void clear() {
+        for (Entry& entry : entries) entry.finished = true;
+        retireFinished();
+    }
+
+private:
+    struct Entry {
+        EffectId id;
+        ParticleEffect effect;
+        float duration;
+        float elapsed;
+        bool cancelled;
+        bool finished = false;
+    };
+
+    std::vector<Entry> entries;     // in add() order, which is also draw order
+    std::vector<WINDOW*> windows;   // scratch: distinct windows in this tick
+    EffectId nextId = 1;
+
+    void retireFinished() {
+        for (Entry& entry : entries) {
+            if (!entry.finished) continue;
+            if (WINDOW* window = entry.effect.getWindow()) {
+                entry.effect.eraseTrail();   // other effects may keep the window registered
+                ParticleWindowRegistry::unregisterWindow(window);
+                wnoutrefresh(window);
+            }
+        }
+        entries.erase(std::remove_if(entries.begin(), entries.end(),
+                          [](const Entry& entry) { return entry.finished; }),
+                      entries.end());
     }
 };
 
@@ -525,14 +1208,19 @@ public:
  *
  * This is a high-level helper function that creates, spawns, animates, and cleans up
  * a particle burst effect. Useful for quick one-off effects like success celebrations.
+ * It blocks until the effect ends - use an EffectManager to run effects alongside input
+ * and other animation.
  *
  * @param window The window to render particles on
  * @param spawnPoints Vector of positions where particles will burst from
  * @param prototype The particle template (physics, color, lifetime, etc.)
- * @param duration How long to animate the effect in seconds (default: 0.5s)
+ * @param duration How long to animate the effect in seconds (default: 0.5s). 0 or less
+ *                 animates nothing and returns at once.
  * @param particlesPerPoint How many particles spawn from each point (default: 3)
  * @param minSpeed Minimum particle speed (default: 6.0)
  * @param maxSpeed Maximum particle speed (default: 12.0)
+ * @param seed Seed for the particles' random directions, speeds and turbulence (default: random).
+ *             Frames are stepped by measured time, so only the spawn pattern replays exactly.
  *
  * Example usage:
  * @code
@@ -551,16 +1239,18 @@ inline void spawnBurst(WINDOW* window,
                        float duration = 0.5f,
                        int particlesPerPoint = 3,
                        float minSpeed = 6.0f,
-                       float maxSpeed = 12.0f)
+                       float maxSpeed = 12.0f,
+                       std::optional<uint64_t> seed = std::nullopt)
 {
-    // Register window (creates snapshot if first effect on this window)
-    ParticleWindowRegistry::registerWindow(window);
-
     // NOTE: Particles currently render above all window content.
     // See file header comment for future layering enhancement design.
 
+    // No time to animate in. (Left to the manager, a duration of 0 would mean "until every
+    // particle dies" and block for the prototype's whole lifetime.)
+    if (duration <= 0.0f) return;
+
     // Create and configure the effect
-    ParticleEffect effect(window);
+    ParticleEffect effect(window, seed);
     for (const Vec2& point : spawnPoints) {
         effect.addSpawnPoint(point.x, point.y);
     }
@@ -570,29 +1260,15 @@ inline void spawnBurst(WINDOW* window,
     // Spawn particles
     effect.spawn(prototype);
 
-    // Animate for specified duration
-    auto startTime = std::chrono::high_resolution_clock::now();
-
-    while (true) {
-        auto currentTime = std::chrono::high_resolution_clock::now();
-        std::chrono::duration<float> elapsed = currentTime - startTime;
-        if (elapsed.count() >= duration) break;
-
-        float deltaTime = 0.016f;  // ~60 FPS
-        effect.update(deltaTime);
-
-        // Restore original window content before rendering particles (prevents trails)
-        ParticleWindowRegistry::restoreWindow(window);
-
-        // Render particles (render() now handles wnoutrefresh internally)
-        effect.render();
-        doupdate();  // Push virtual screen to physical screen
-
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+    // Animate for specified duration at ~60 FPS, stepping physics by the measured frame time.
+    // The manager registers the window (snapshotting it) and restores it when the effect retires.
+    EffectManager effects;
+    effects.add(std::move(effect), duration);
+    FrameScheduler frames(60.0);
+    while (!effects.empty()) {
+        effects.tick(frames.beginFrame());
+        frames.endFrame();
     }
-
-    // Unregister window (restores and cleans up snapshot if last effect)
-    ParticleWindowRegistry::unregisterWindow(window);
 }
 
 } // namespace ParticleFX
@@ -23,6 +23,8 @@ struct ParticlePhysics {
 
     ParticlePhysics(float g, float d, float b, float t, Vec2 gravDir)
         : gravity(g), drag(d), bounce(b), turbulence(t), gravityDirection(gravDir) {}
+
+    bool operator==(const ParticlePhysics& other) const = default;
 };
 
 /**
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <random>
+
+namespace stevensTerminal {
+namespace ParticleFX {
+
+/**
+ * @brief Small, fast, seedable random generator for particle simulation (xoshiro128+).
+ *
+ * 16 bytes of state and a handful of integer ops per draw - several times cheaper than
+ * std::mt19937 with a std::uniform_real_distribution - and the output depends only on the seed,
+ * not on the standard library's distribution implementations, so a seeded effect replays
+ * identically on every platform.
+ *
+ * Satisfies UniformRandomBitGenerator, so it also works with the <random> distributions.
+ */
+class ParticleRng {
+public:
+    using result_type = uint32_t;
+
+    explicit ParticleRng(uint64_t seedValue = 0x9E3779B97F4A7C15ull) { seed(seedValue); }
+
+    /**
+     * @brief A generator seeded from std::random_device, for effects that don't need replaying
+     */
+    static ParticleRng fromRandomDevice() {
+        std::random_device device;
+        return ParticleRng((static_cast<uint64_t>(device()) << 32) | device());
+    }
+
+    /**
+     * @brief An independent generator for one of several parallel streams from the same seed
+     * (e.g. one per worker thread). Each (seed, streamIndex) pair gives its own sequence.
+     */
+    static ParticleRng stream(uint64_t seedValue, uint64_t streamIndex) {
+        uint64_t mixed = seedValue;
+        splitMix(mixed);
+        return ParticleRng(mixed ^ (streamIndex * 0xD1B54A32D192ED03ull));
+    }
+
+    /**
+     * @brief Restart the sequence. The state is expanded from the seed with SplitMix64, so
+     * nearby seeds still give unrelated sequences.
+     */
+    void seed(uint64_t seedValue) {
+        uint64_t a = splitMix(seedValue);
+        uint64_t b = splitMix(seedValue);
+        state[0] = static_cast<uint32_t>(a);
+        state[1] = static_cast<uint32_t>(a >> 32);
+        state[2] = static_cast<uint32_t>(b);
+        state[3] = static_cast<uint32_t>(b >> 32);
+        if ((state[0] | state[1] | state[2] | state[3]) == 0) state[0] = 1; // all-zero state is a fixed point
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<uint32_t>::max(); }
+
+    result_type operator()() {
+        const uint32_t result = state[0] + state[3];
+        const uint32_t t = state[1] << 9;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = (state[3] << 11) | (state[3] >> 21);
+        return result;
+    }
+
+    /**
+     * @brief Uniform float in [0, 1), from the generator's top 24 bits (its best ones)
+     */
+    float uniform() { return static_cast<float>((*this)() >> 8) * 0x1.0p-24f; }
+
+    /**
+     * @brief Uniform float in [low, high)
+     */
+    float uniform(float low, float high) { return low + (high - low) * uniform(); }
+
+    /**
+     * @brief Uniform int in [low, high], inclusive like std::uniform_int_distribution
+     */
+    int uniformInt(int low, int high) {
+        if (high <= low) return low;
+        uint64_t range = static_cast<uint64_t>(static_cast<int64_t>(high) - low) + 1;
+        return static_cast<int>(low + static_cast<int64_t>((static_cast<uint64_t>((*this)()) * range) >> 32));
+    }
+
+    /**
+     * @brief Fill out[0, count) with uniform floats in [low, high)
+     */
+    void fillUniform(float* out, size_t count, float low, float high) {
+        const float scale = (high - low) * 0x1.0p-24f;
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = low + static_cast<float>((*this)() >> 8) * scale;
+        }
+    }
+
+private:
+    uint32_t state[4];
+
+    static uint64_t splitMix(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+};
+
+} // namespace ParticleFX
+} // namespace stevensTerminal
@@ -0,0 +1,199 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "Vec2.hpp"
+#include "ParticlePhysics.hpp"
+#include "OccupancyMap.hpp"
+
+namespace stevensTerminal {
+namespace ParticleFX {
+
+/**
+ * @brief Structure-of-arrays particle pool for one particle group (particles sharing a prototype).
+ *
+ * Each field lives in its own contiguous array, so the update kernel streams through exactly the
+ * floats it needs and the compiler can vectorize it. Physics and appearance are not stored per
+ * particle - every particle in the pool shares its group's.
+ *
+ * The arrays are sized to capacity() and only [0, size()) is live. Dead particles are
+ * swap-removed and new ones claimed in bulk from the free tail, so once the pool has grown to an
+ * effect's working size, spawning and expiring particles never allocates.
+ */
+class ParticleArrays {
+public:
+    std::vector<float> x, y;
+    std::vector<float> vx, vy;
+    std::vector<float> age, lifetime;
+
+    size_t size() const { return count; }
+    size_t capacity() const { return x.size(); }
+    bool empty() const { return count == 0; }
+
+    void reserve(size_t slots) {
+        if (slots <= capacity()) return;
+        x.resize(slots); y.resize(slots);
+        vx.resize(slots); vy.resize(slots);
+        age.resize(slots); lifetime.resize(slots);
+    }
+
+    /**
+     * @brief Claim `wanted` slots at the end of the live range, growing the pool (at least
+     * doubling) if needed. Claimed slots hold stale data - the caller fills every field.
+     * @return Index of the first claimed slot
+     */
+    size_t claim(size_t wanted) {
+        size_t first = count;
+        if (first + wanted > capacity()) {
+            reserve(std::max(first + wanted, capacity() * 2));
+        }
+        count = first + wanted;
+        return first;
+    }
+
+    void push(Vec2 position, Vec2 velocity, float startAge, float life) {
+        size_t i = claim(1);
+        x[i] = position.x; y[i] = position.y;
+        vx[i] = velocity.x; vy[i] = velocity.y;
+        age[i] = startAge; lifetime[i] = life;
+    }
+
+    void clear() { count = 0; }
+
+    /**
+     * @brief Drop particles whose age has reached their lifetime by moving the last live
+     * particle into each dead slot. Survivors don't keep their order.
+     * @return Number of particles removed
+     */
+    size_t removeDead() {
+        size_t before = count;
+        size_t i = 0;
+        while (i < count) {
+            if (age[i] < lifetime[i]) {
+                ++i;
+                continue;
+            }
+            size_t last = --count;
+            x[i] = x[last]; y[i] = y[last];
+            vx[i] = vx[last]; vy[i] = vy[last];
+            age[i] = age[last]; lifetime[i] = lifetime[last];
+        }
+        return before - count;
+    }
+
+private:
+    size_t count = 0;
+};
+
+/**
+ * @brief Area particles bounce inside: [minX, maxX) x [minY, maxY)
+ */
+struct ParticleBounds {
+    float minX = 0.0f, maxX = 80.0f;
+    float minY = 0.0f, maxY = 24.0f;
+};
+
+namespace ParticleKernels {
+
+    namespace detail {
+        template <bool Turbulent, bool Collide>
+        inline void integrate(ParticleArrays& particles, size_t begin, size_t end,
+                              const ParticlePhysics& physics, float deltaTime,
+                              const ParticleBounds& bounds, const float* __restrict noise,
+                              const OccupancyMap* obstacles) {
+            float* __restrict px = particles.x.data() + begin;
+            float* __restrict py = particles.y.data() + begin;
+            float* __restrict pvx = particles.vx.data() + begin;
+            float* __restrict pvy = particles.vy.data() + begin;
+            float* __restrict page = particles.age.data() + begin;
+            const size_t count = end - begin;
+
+            const float gravityX = physics.gravityDirection.x * physics.gravity * deltaTime;
+            const float gravityY = physics.gravityDirection.y * physics.gravity * deltaTime;
+            const float damping = 1.0f - physics.drag;
+            const float bounce = physics.bounce;
+            const float rightEdge = bounds.maxX - 1.0f;
+            const float bottomEdge = bounds.maxY - 1.0f;
+
+            for (size_t i = 0; i < count; ++i) {
+                page[i] += deltaTime;
+                float vx = (pvx[i] + gravityX) * damping;
+                float vy = (pvy[i] + gravityY) * damping;
+                if constexpr (Turbulent) {
+                    vx += noise[i];
+                    vy += noise[count + i];
+                }
+                float x = px[i] + vx * deltaTime;
+                float y = py[i] + vy * deltaTime;
+
+                // Reflect off the edges: past the left/top edge the velocity points back in, past
+                // the right/bottom edge it points back out, scaled by the bounce factor
+                const bool left = x < bounds.minX;
+                const bool right = x >= bounds.maxX;
+                const bool top = y < bounds.minY;
+                const bool bottom = y >= bounds.maxY;
+                x = left ? bounds.minX : (right ? rightEdge : x);
+                y = top ? bounds.minY : (bottom ? bottomEdge : y);
+                vx = left ? std::fabs(vx) * bounce : (right ? -std::fabs(vx) * bounce : vx);
+                vy = top ? std::fabs(vy) * bounce : (bottom ? -std::fabs(vy) * bounce : vy);
+
+                if constexpr (Collide) {
+                    // Moving into a solid cell reflects the axis that crossed into it: try the
+                    // horizontal move alone, then the vertical. A particle already inside a
+                    // solid cell (spawned on text) is left to move out freely.
+                    const float oldX = px[i];
+                    const float oldY = py[i];
+                    if (!obstacles->occupiedAt(oldX, oldY)) {
+                        // Reflect against the direction moved, which the edge bounce above
+                        // may already have flipped the velocity away from
+                        if (obstacles->occupiedAt(x, oldY)) {
+                            vx = (x > oldX ? -std::fabs(vx) : std::fabs(vx)) * bounce;
+                            x = oldX;
+                        }
+                        if (obstacles->occupiedAt(x, y)) {
+                            vy = (y > oldY ? -std::fabs(vy) : std::fabs(vy)) * bounce;
+                            y = oldY;
+                        }
+                    }
+                }
+
+                px[i] = x;
+                py[i] = y;
+                pvx[i] = vx;
+                pvy[i] = vy;
+            }
+        }
+    } // namespace detail
+
+    /**
+     * @brief Advance particles [begin, end) by one step: age, gravity, drag, turbulence,
+     * integration and boundary bounce.
+     *
+     * Branch-free over plain float arrays so it auto-vectorizes. Turbulence is supplied
+     * pre-drawn: noise holds 2 * (end - begin) values in [-turbulence, turbulence] - every
+     * particle's x offset, then every particle's y offset - or is nullptr when the physics has
+     * no turbulence.
+     *
+     * With obstacles, particles also bounce off its occupied cells. That adds a bitmap lookup
+     * per particle and keeps the loop from vectorizing, so it's only compiled in when asked for.
+     */
+    inline void integrate(ParticleArrays& particles, size_t begin, size_t end,
+                          const ParticlePhysics& physics, float deltaTime,
+                          const ParticleBounds& bounds, const float* noise = nullptr,
+                          const OccupancyMap* obstacles = nullptr) {
+        if (obstacles) {
+            if (noise) detail::integrate<true, true>(particles, begin, end, physics, deltaTime, bounds, noise, obstacles);
+            else       detail::integrate<false, true>(particles, begin, end, physics, deltaTime, bounds, nullptr, obstacles);
+        } else {
+            if (noise) detail::integrate<true, false>(particles, begin, end, physics, deltaTime, bounds, noise, nullptr);
+            else       detail::integrate<false, false>(particles, begin, end, physics, deltaTime, bounds, nullptr, nullptr);
+        }
+    }
+
+} // namespace ParticleKernels
+
+} // namespace ParticleFX
+} // namespace stevensTerminal
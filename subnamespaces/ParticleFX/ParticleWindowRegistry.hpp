@@ -1,6 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <unordered_map>
+#include <vector>
+
+#include "OccupancyMap.hpp"
 
 namespace stevensTerminal {
 namespace ParticleFX {
@@ -10,14 +14,47 @@ namespace ParticleFX {
  *
  * This allows multiple overlapping particle effects to share the same "clean" window snapshot,
  * preventing trails and ensuring proper layering.
+ *
+ * The snapshot's cells are also cached in an array when the window is registered, and effects
+ * record the cells they draw on with markTouched(). Between frames, restoreTouched() then puts
+ * back only those cells, so a frame costs O(particles) rather than O(window area).
  */
 class ParticleWindowRegistry {
 private:
     struct WindowState {
-        WINDOW* snapshot;
-        int refCount;  // How many active effects are using this snapshot
+        WINDOW* snapshot = nullptr;
+        int refCount = 0;  // How many active effects are using this snapshot
+
+        int rows = 0, cols = 0;
+        std::vector<chtype> cells;       // snapshot contents, row-major
+        std::vector<uint8_t> touched;    // 1 for cells drawn on since the last restore
+        std::vector<uint32_t> dirty;     // indices of the touched cells
+
+        OccupancyMap occupancy;          // non-blank snapshot cells, built on first use
+        bool occupancyStale = true;      // snapshot changed since occupancy was built
     };
 
+    /**
+     * Copy the snapshot's cells into the cache. Any built occupancy map is now out of date.
+     */
+    static void cacheCells(WindowState& state) {
+        getmaxyx(state.snapshot, state.rows, state.cols);
+        state.cells.resize(static_cast<size_t>(state.rows) * state.cols);
+        state.touched.assign(state.cells.size(), 0);
+        state.dirty.clear();
+        for (int y = 0; y < state.rows; ++y) {
+            for (int x = 0; x < state.cols; ++x) {
+                state.cells[static_cast<size_t>(y) * state.cols + x] = mvwinch(state.snapshot, y, x);
+            }
+        }
+        state.occupancyStale = true;
+    }
+
+    static WindowState* find(WINDOW* window) {
+        auto it = registry.find(window);
+        return it == registry.end() ? nullptr : &it->second;
+    }
+
     static std::unordered_map<WINDOW*, WindowState> registry;
 
 public:
@@ -26,8 +63,12 @@ public:
      */
     static void registerWindow(WINDOW* window) {
         if (registry.find(window) == registry.end()) {
-            // First effect on this window - create snapshot
-            registry[window] = {dupwin(window), 1};
+            // First effect on this window - create snapshot and cache its cells
+            WindowState state;
+            state.snapshot = dupwin(window);
+            state.refCount = 1;
+            cacheCells(state);
+            registry[window] = std::move(state);
         } else {
             // Additional effect - increment ref count
             registry[window].refCount++;
@@ -57,7 +98,106 @@ public:
         auto it = registry.find(window);
         if (it != registry.end()) {
             overwrite(it->second.snapshot, window);
+            for (uint32_t index : it->second.dirty) it->second.touched[index] = 0;
+            it->second.dirty.clear();
+        }
+    }
+
+    /**
+     * @brief Restore only the cells marked with markTouched() since the last restore
+     * @return Number of cells restored
+     */
+    static size_t restoreTouched(WINDOW* window) {
+        WindowState* state = find(window);
+        if (!state) return 0;
+        size_t restored = state->dirty.size();
+        for (uint32_t index : state->dirty) {
+            int y = static_cast<int>(index / state->cols);
+            int x = static_cast<int>(index % state->cols);
+            copywin(state->snapshot, window, y, x, y, x, y, x, FALSE);
+            state->touched[index] = 0;
+        }
+        state->dirty.clear();
+        return restored;
+    }
+
+    /**
+     * @brief Put back a single cell from the snapshot now
+     * @return False if the window isn't registered or the cell is outside its snapshot
+     */
+    static bool restoreCell(WINDOW* window, int y, int x) {
+        WindowState* state = find(window);
+        if (!state || y < 0 || x < 0 || y >= state->rows || x >= state->cols) return false;
+        copywin(state->snapshot, window, y, x, y, x, y, x, FALSE);
+        return true;
+    }
+
+    /**
+     * @brief Record that an effect drew on (y, x), so restoreTouched() puts it back
+     * @return False if the window isn't registered or the cell is outside its snapshot
+     */
+    static bool markTouched(WINDOW* window, int y, int x) {
+        WindowState* state = find(window);
+        if (!state || y < 0 || x < 0 || y >= state->rows || x >= state->cols) return false;
+        uint32_t index = static_cast<uint32_t>(y * state->cols + x);
+        if (!state->touched[index]) {
+            state->touched[index] = 1;
+            state->dirty.push_back(index);
         }
+        return true;
+    }
+
+    /**
+     * @brief The snapshot's content at (y, x) - what's underneath any particles - without
+     * reading the window back. Returns false if the window isn't registered or (y, x) is outside it.
+     */
+    static bool snapshotCell(WINDOW* window, int y, int x, chtype& cell) {
+        WindowState* state = find(window);
+        if (!state || y < 0 || x < 0 || y >= state->rows || x >= state->cols) return false;
+        cell = state->cells[static_cast<size_t>(y) * state->cols + x];
+        return true;
+    }
+
+    /**
+     * @brief Re-take the snapshot from the window's current contents, e.g. after the text
+     * under a running effect changed. Call it once particles have been cleared off the window
+     * (after restoreTouched() and redrawing the content), or they become part of the snapshot.
+     */
+    static void refreshSnapshot(WINDOW* window) {
+        WindowState* state = find(window);
+        if (!state) return;
+        int rows, cols;
+        getmaxyx(window, rows, cols);
+        if (rows != state->rows || cols != state->cols) {
+            delwin(state->snapshot);
+            state->snapshot = dupwin(window);
+        } else {
+            overwrite(window, state->snapshot);
+        }
+        cacheCells(*state);
+    }
+
+    /**
+     * @brief Occupancy bitmap of the window's snapshot - its non-blank cells - for particle
+     * collisions. Built on first use and again only after the snapshot changes.
+     * @return nullptr if the window isn't registered
+     */
+    static const OccupancyMap* occupancy(WINDOW* window) {
+        WindowState* state = find(window);
+        if (!state) return nullptr;
+        if (state->occupancyStale) {
+            state->occupancy.build(state->rows, state->cols, state->cells.data());
+            state->occupancyStale = false;
+        }
+        return &state->occupancy;
+    }
+
+    /**
+     * @brief Number of cells currently waiting for restoreTouched()
+     */
+    static size_t touchedCount(WINDOW* window) {
+        WindowState* state = find(window);
+        return state ? state->dirty.size() : 0;
     }
 
     /**
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace stevensTerminal {
+namespace ParticleFX {
+
+/**
+ * @brief How render() maps particles onto cells
+ */
+enum class RenderMode {
+    Cell,       // One particle per cell, drawn with its own character (default)
+    HalfBlock,  // 1x2 dots per cell: ▀ ▄ █
+    Braille     // 2x4 dots per cell: U+2800-U+28FF
+};
+
+/**
+ * @brief Which particle's colour a cell shared by several particles takes
+ */
+enum class SubCellColor {
+    Latest,    // The last particle drawn into the cell (highest layer wins)
+    Dominant   // The colour most of the cell's particles have
+};
+
+/**
+ * @brief Per-cell dot masks for sub-cell particle rendering.
+ *
+ * Particles are plotted at fractional positions and set one dot of their cell's mask; the
+ * cells covered are remembered in plot order, so drawing writes each covered cell once no
+ * matter how many particles landed in it, and clearing costs only what was covered. Pure
+ * data - no curses calls.
+ */
+class SubCellGrid {
+public:
+    /**
+     * @brief Size the grid for a rows x cols area and drop anything plotted. Keeps its
+     * allocation when the area doesn't grow.
+     */
+    void reset(RenderMode renderMode, int rowCount, int colCount, SubCellColor colorMode = SubCellColor::Latest) {
+        clear();
+        mode = renderMode;
+        colorChoice = colorMode;
+        rows = rowCount > 0 ? rowCount : 0;
+        cols = colCount > 0 ? colCount : 0;
+        size_t cells = static_cast<size_t>(rows) * cols;
+        if (masks.size() < cells) {
+            masks.resize(cells, 0);
+            colors.resize(cells, 0);
+            votes.resize(cells, 0);
+        }
+    }
+
+    /**
+     * @brief Forget plotted dots. Only the covered cells are touched.
+     */
+    void clear() {
+        for (uint32_t index : covered) {
+            masks[index] = 0;
+            votes[index] = 0;
+        }
+        covered.clear();
+    }
+
+    /**
+     * @brief Set the dot under (x, y) in the colour pair. Cell c spans [c - 0.5, c + 0.5) on
+     * each axis, matching the rounding of RenderMode::Cell.
+     * @return False if the position is outside the grid
+     */
+    bool plot(float x, float y, int colorPair) {
+        const int dotsWide = mode == RenderMode::Braille ? 2 : 1;
+        const int dotsHigh = mode == RenderMode::Braille ? 4 : 2;
+        float dotX = std::floor((x + 0.5f) * dotsWide);
+        float dotY = std::floor((y + 0.5f) * dotsHigh);
+        if (dotX < 0.0f || dotY < 0.0f) return false;
+        int subX = static_cast<int>(dotX);
+        int subY = static_cast<int>(dotY);
+        int col = subX / dotsWide;
+        int row = subY / dotsHigh;
+        if (col >= cols || row >= rows) return false;
+
+        uint32_t index = static_cast<uint32_t>(row) * cols + col;
+        if (masks[index] == 0) covered.push_back(index);
+        masks[index] |= dotBit(subX % dotsWide, subY % dotsHigh);
+
+        if (colorChoice == SubCellColor::Latest || votes[index] == 0) {
+            colors[index] = colorPair;
+            votes[index] = 1;
+        } else if (colors[index] == colorPair) {
+            if (votes[index] < UINT16_MAX) ++votes[index];
+        } else {
+            --votes[index];   // Majority vote: the pair left standing is the dominant one
+        }
+        return true;
+    }
+
+    /** @brief Covered cell indices (row * cols() + col), in the order they were first plotted */
+    const std::vector<uint32_t>& coveredCells() const { return covered; }
+
+    int rowCount() const { return rows; }
+    int colCount() const { return cols; }
+    uint8_t mask(uint32_t index) const { return masks[index]; }
+    int colorPair(uint32_t index) const { return colors[index]; }
+
+    /**
+     * @brief The UTF-8 glyph for a cell's dots, written into out (at least 4 bytes) and
+     * NUL-terminated
+     */
+    void glyph(uint32_t index, char* out) const {
+        uint8_t bits = masks[index];
+        if (mode == RenderMode::Braille) {
+            // U+2800 + bits: E2 A0-A3 80-BF
+            out[0] = static_cast<char>(0xE2);
+            out[1] = static_cast<char>(0xA0 | (bits >> 6));
+            out[2] = static_cast<char>(0x80 | (bits & 0x3F));
+        } else {
+            // ▀ U+2580, ▄ U+2584, █ U+2588
+            out[0] = static_cast<char>(0xE2);
+            out[1] = static_cast<char>(0x96);
+            out[2] = static_cast<char>(bits == 0x1 ? 0x80 : (bits == 0x2 ? 0x84 : 0x88));
+        }
+        out[3] = '\0';
+    }
+
+private:
+    RenderMode mode = RenderMode::Braille;
+    SubCellColor colorChoice = SubCellColor::Latest;
+    int rows = 0, cols = 0;
+    std::vector<uint8_t> masks;
+    std::vector<int> colors;
+    std::vector<uint16_t> votes;
+    std::vector<uint32_t> covered;
+
+    /**
+     * Braille numbers its dots down the left column (bits 0-2), down the right column
+     * (bits 3-5), then the bottom row left and right (bits 6, 7). Half blocks use bit 0 for
+     * the upper half and bit 1 for the lower.
+     */
+    uint8_t dotBit(int subX, int subY) const {
+        if (mode != RenderMode::Braille) return static_cast<uint8_t>(1u << subY);
+        if (subY == 3) return static_cast<uint8_t>(subX ? 0x80 : 0x40);
+        return static_cast<uint8_t>(1u << (subY + 3 * subX));
+    }
+};
+
+} // namespace ParticleFX
+} // namespace stevensTerminal
@@ -18,6 +18,7 @@ struct Vec2 {
     Vec2 operator-(const Vec2& other) const { return {x - other.x, y - other.y}; }
     Vec2 operator*(float scalar) const { return {x * scalar, y * scalar}; }
     Vec2& operator+=(const Vec2& other) { x += other.x; y += other.y; return *this; }
+    bool operator==(const Vec2& other) const { return x == other.x && y == other.y; }
 
     float length() const { return std::sqrt(x * x + y * y); }
     Vec2 normalized() const {
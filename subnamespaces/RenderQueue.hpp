@@ -0,0 +1,296 @@
+#pragma once
+/**
+ * @file RenderQueue.hpp
+ * @brief Lock-free multi-producer render command queue, drained by the render thread.
+ *
+ * ncurses is not thread-safe, so worker threads (loaders, simulations) must not call the print
+ * APIs themselves. Instead they submit commands here - print styled text, set a bar's value,
+ * append a line to a log pane - without taking a lock or touching the terminal, and the render
+ * thread applies them once per frame with drain(). Redundant updates are coalesced: of several
+ * prints or bar values aimed at the same window position in one frame, only the newest is drawn,
+ * and a log pane is redrawn once however many lines were appended to it.
+ *
+ * Usage:
+ *   stevensTerminal::RenderQueue renderQueue;
+ *   // any thread:
+ *   renderQueue.setBar(statusWin, 1, 2, loaded, total);
+ *   renderQueue.appendLog(logWin, "Loaded " + name);
+ *   // render thread, once per frame:
+ *   renderQueue.drain();
+ *   stevensTerminal::windowManager().refreshAll();
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+#include "Core.hpp"
+#include "Bar.hpp"
+
+namespace stevensTerminal
+{
+    /**
+     * @brief curses_wprint() the text at (y, x) of win.
+     */
+    struct PrintCommand
+    {
+        WINDOW*     win = nullptr;
+        int         y   = 0;
+        int         x   = 0;
+        std::string text;
+        std::unordered_map<std::string,std::string> style  = {};
+        std::unordered_map<std::string,std::string> format = {};
+    };
+
+    /**
+     * @brief printBar() at (y, x) of win.
+     */
+    struct BarCommand
+    {
+        WINDOW* win     = nullptr;
+        int     y       = 0;
+        int     x       = 0;
+        int     current = 0;
+        int     total   = 1;
+        BarSpec spec    = {};
+    };
+
+    /**
+     * @brief Append a line to the log pane occupying win.
+     */
+    struct LogCommand
+    {
+        WINDOW*     win = nullptr;
+        std::string line;
+    };
+
+    /**
+     * @brief Run arbitrary drawing code on the render thread. Never coalesced.
+     */
+    struct CallCommand
+    {
+        std::function<void()> call;
+    };
+
+    using RenderCommand = std::variant<PrintCommand, BarCommand, LogCommand, CallCommand>;
+
+
+    /**
+     * @brief Multi-producer, single-consumer queue of RenderCommands.
+     *
+     * Submitting is wait-free apart from allocating the queue node: one atomic exchange and one
+     * store (Vyukov's node-based MPSC queue). Only the render thread may call drain().
+     */
+    class RenderQueue
+    {
+    public:
+        RenderQueue()
+            : head(new Node{{nullptr}, CallCommand{}})
+            , tail(head.load(std::memory_order_relaxed))
+        {}
+
+        ~RenderQueue()
+        {
+            RenderCommand discarded;
+            while (pop(discarded)) {}
+            delete tail;
+        }
+
+        RenderQueue(const RenderQueue&) = delete;
+        RenderQueue& operator=(const RenderQueue&) = delete;
+
+        /** @brief Submit a command. Safe from any thread. */
+        void submit(RenderCommand command)
+        {
+            Node* node = new Node{{nullptr}, std::move(command)};
+            Node* previous = head.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        void print(WINDOW* win, int y, int x, std::string text,
+                   std::unordered_map<std::string,std::string> style = {},
+                   std::unordered_map<std::string,std::string> format = {})
+        {
+            submit(PrintCommand{win, y, x, std::move(text), std::move(style), std::move(format)});
+        }
+
+        void setBar(WINDOW* win, int y, int x, int current, int total, BarSpec spec = {})
+        {
+            submit(BarCommand{win, y, x, current, total, std::move(spec)});
+        }
+
+        void appendLog(WINDOW* win, std::string line)
+        {
+            submit(LogCommand{win, std::move(line)});
+        }
+
+        void post(std::function<void()> call)
+        {
+            submit(CallCommand{std::move(call)});
+        }
+
+        /**
+         * @brief Apply every command submitted so far. Render thread only.
+         *
+         * Commands run in submission order, except that a print or bar update is skipped when a
+         * later one in the same drain targets the same window and position. Log panes touched by
+         * the drain are redrawn once, after everything else.
+         *
+         * @return Number of commands applied (submitted minus coalesced).
+         */
+        size_t drain()
+        {
+            batch.clear();
+            RenderCommand command;
+            while (pop(command)) batch.push_back(std::move(command));
+            if (batch.empty()) return 0;
+
+            // Last occurrence of each (kind, window, position) in this batch
+            lastAt.clear();
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                if (auto key = coalesceKey(batch[i])) lastAt[*key] = i;
+            }
+
+            size_t applied = 0;
+            dirtyLogs.clear();
+            for (size_t i = 0; i < batch.size(); ++i)
+            {
+                RenderCommand& command = batch[i];
+                if (auto key = coalesceKey(command); key && lastAt[*key] != i)
+                {
+                    ++coalescedTotal;
+                    continue;
+                }
+                apply(command);
+                ++applied;
+            }
+            for (WINDOW* win : dirtyLogs) redrawLog(win);
+            return applied;
+        }
+
+        /** @brief Commands dropped as redundant since construction. */
+        size_t coalescedCount() const { return coalescedTotal; }
+
+        /** @brief Lines currently held for a log pane (at most its window height). */
+        const std::deque<std::string>* logLines(WINDOW* win) const
+        {
+            auto it = logs.find(win);
+            return it == logs.end() ? nullptr : &it->second;
+        }
+
+        /** @brief Forget a log pane's lines, e.g. before deleting its window. Render thread only. */
+        void forgetLog(WINDOW* win) { logs.erase(win); }
+
+    private:
+        struct Node
+        {
+            std::atomic<Node*> next;
+            RenderCommand      command;
+        };
+
+        struct CoalesceKey
+        {
+            uintptr_t win;
+            int       y;
+            int       x;
+            size_t    kind;
+
+            bool operator==(const CoalesceKey& other) const = default;
+        };
+
+        struct CoalesceKeyHash
+        {
+            size_t operator()(const CoalesceKey& key) const
+            {
+                size_t h = std::hash<uintptr_t>()(key.win);
+                h ^= (static_cast<size_t>(key.y) * 0x9E3779B97F4A7C15ull) + (h << 6) + (h >> 2);
+                h ^= (static_cast<size_t>(key.x) * 0xC2B2AE3D27D4EB4Full) + (h << 6) + (h >> 2);
+                return h ^ key.kind;
+            }
+        };
+
+        std::atomic<Node*> head; // newest node; producers swap themselves in here
+        Node*              tail; // consumed dummy node whose successor is the oldest command
+
+        // Consumer-only state, reused across drains
+        std::vector<RenderCommand>                                batch;
+        std::unordered_map<CoalesceKey, size_t, CoalesceKeyHash>  lastAt;
+        std::vector<WINDOW*>                                      dirtyLogs;
+        std::unordered_map<WINDOW*, std::deque<std::string>>      logs;
+        size_t                                                    coalescedTotal = 0;
+
+        /**
+         * Pop the oldest command. The queue always holds one already-consumed dummy node at
+         * `tail`; popping moves the next node's command out, frees the dummy and makes that node
+         * the new dummy.
+         */
+        bool pop(RenderCommand& out)
+        {
+            Node* first = tail;
+            Node* next = first->next.load(std::memory_order_acquire);
+            if (!next) return false; // empty, or a producer is between its exchange and its store
+
+            out = std::move(next->command);
+            tail = next;
+            delete first;
+            return true;
+        }
+
+        static std::optional<CoalesceKey> coalesceKey(const RenderCommand& command)
+        {
+            if (const PrintCommand* print = std::get_if<PrintCommand>(&command))
+                return CoalesceKey{reinterpret_cast<uintptr_t>(print->win), print->y, print->x, 0};
+            if (const BarCommand* bar = std::get_if<BarCommand>(&command))
+                return CoalesceKey{reinterpret_cast<uintptr_t>(bar->win), bar->y, bar->x, 1};
+            return std::nullopt;
+        }
+
+        void apply(RenderCommand& command)
+        {
+            if (PrintCommand* print = std::get_if<PrintCommand>(&command))
+            {
+                if (print->win)
+                    PrintHelper::curses_wprint(print->win, print->y, print->x, print->text,
+                                               print->style, print->format, textStyling);
+            }
+            else if (BarCommand* bar = std::get_if<BarCommand>(&command))
+            {
+                printBar(bar->win, bar->y, bar->x, bar->current, bar->total, bar->spec);
+            }
+            else if (LogCommand* log = std::get_if<LogCommand>(&command))
+            {
+                if (!log->win) return;
+                std::deque<std::string>& lines = logs[log->win];
+                lines.push_back(std::move(log->line));
+                size_t capacity = static_cast<size_t>(std::max(getmaxy(log->win), 1));
+                while (lines.size() > capacity) lines.pop_front();
+                if (std::find(dirtyLogs.begin(), dirtyLogs.end(), log->win) == dirtyLogs.end())
+                    dirtyLogs.push_back(log->win);
+            }
+            else if (CallCommand* call = std::get_if<CallCommand>(&command))
+            {
+                if (call->call) call->call();
+            }
+        }
+
+        void redrawLog(WINDOW* win)
+        {
+            const std::deque<std::string>& lines = logs[win];
+            werase(win);
+            int row = 0;
+            for (const std::string& line : lines)
+            {
+                PrintHelper::curses_wprint(win, row++, 0, line, {}, {}, textStyling);
+            }
+        }
+    };
+
+} // namespace stevensTerminal
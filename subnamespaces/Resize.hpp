@@ -0,0 +1,83 @@
+#pragma once
+/**
+ * @file Resize.hpp
+ * @brief Coalesced terminal-resize handling with cached screen geometry.
+ *
+ * Dragging a terminal edge delivers a storm of SIGWINCHs. Once startResizeWatch() is called, the
+ * signal handler only writes a byte to a self-pipe; pollResize(), called from the main loop, waits
+ * for the storm to go quiet for the debounce interval and then handles the settled size once:
+ * it refreshes the cached geometry returned by get_screen_size() (no ioctl per call), resizes the
+ * curses screen, re-evaluates the display mode only if the new size left the current mode's
+ * bounds, and fires the callback.
+ *
+ * Usage:
+ *   stevensTerminal::initialize();
+ *   stevensTerminal::startResizeWatch([&](const stevensTerminal::ResizeEvent& event) {
+ *       layout.apply(stevensTerminal::windowManager(), event.width, event.height);
+ *       redrawEverything();
+ *   });
+ *   while (running) {
+ *       stevensTerminal::pollResize();
+ *       ...
+ *   }
+ */
+
+#include <chrono>
+#include <functional>
+#include <string>
+
+namespace stevensTerminal
+{
+    /**
+     * @brief A settled terminal size, as passed to the resize callback.
+     *
+     * width / height      — terminal size in cells
+     * displayMode         — display mode for this size (also stored in currentDisplayMode)
+     * displayModeChanged  — the resize crossed a display mode breakpoint
+     */
+    struct ResizeEvent
+    {
+        int         width              = 0;
+        int         height             = 0;
+        std::string displayMode;
+        bool        displayModeChanged = false;
+    };
+
+    using ResizeCallback = std::function<void(const ResizeEvent& event)>;
+
+    /**
+     * @brief Start catching terminal resizes. Call after initialize().
+     *
+     * Installs a SIGWINCH handler that chains to the one ncurses installed, so KEY_RESIZE keeps
+     * working. While the watch is active get_screen_size() returns a cached value that is only
+     * re-queried once a resize has settled.
+     *
+     * @param onResize  Called from pollResize(), once per settled size that differs from the last.
+     * @param debounce  How long the terminal must stop resizing before the size counts as settled.
+     */
+    void startResizeWatch(ResizeCallback onResize,
+                          std::chrono::milliseconds debounce = std::chrono::milliseconds(50));
+
+    /**
+     * @brief Restore the previous SIGWINCH handler and stop caching the screen size.
+     */
+    void stopResizeWatch();
+
+    /**
+     * @brief Handle pending resize signals. Call once per main-loop iteration (it does not block).
+     * @return true if the callback fired.
+     */
+    bool pollResize();
+
+    /**
+     * @brief Whether a resize has been signalled but has not settled yet.
+     */
+    bool resizePending();
+
+    /**
+     * @brief Read end of the resize self-pipe, for loops that wait in poll()/select().
+     * @return -1 when not watching, or on platforms without SIGWINCH.
+     */
+    int resizeEventFd();
+
+} // namespace stevensTerminal
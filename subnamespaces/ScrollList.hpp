@@ -0,0 +1,538 @@
+#pragma once
+/**
+ * @file ScrollList.hpp
+ * @brief Virtualized scrolling list widget for very large in-memory collections.
+ *
+ * curses_mvw_printVector() formats every element of the vector it is handed, even when only a
+ * screenful of them can ever be seen. ScrollList instead pulls items on demand from a data
+ * source callback (index -> styled text) and only ever formats the visible slice plus a small
+ * prefetch margin, so listing 100k log lines costs the same per frame as listing 40.
+ *
+ * Usage:
+ *   stevensTerminal::ScrollList list(win, inventory.size(), [&](size_t i) {
+ *       return stevensTerminal::style(inventory[i].name, {{"textColor", "yellow"}});
+ *   });
+ *   list.select(0);
+ *   list.render();       // draws only the rows that changed since the last render()
+ *   list.jumpTo(5000);   // O(1) - no walk over the 5000 items before it
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "Core.hpp"
+
+namespace stevensTerminal
+{
+    /**
+     * @brief Spec for a ScrollList.
+     *
+     * top / left        — where the list's region starts inside the window
+     * height / width    — size of the region; -1 means "to the window's bottom/right edge"
+     * prefetch          — items formatted (and kept cached) ahead of and behind the visible slice
+     * wrap              — wrap long items over several rows (variable-height items); when false
+     *                     every item occupies exactly one row
+     * highlightSelection — draw the selected item in reverse video
+     * style             — style applied to any text in an item not covered by an inline style token
+     */
+    struct ScrollListSpec
+    {
+        int  top                = 0;
+        int  left               = 0;
+        int  height             = -1;
+        int  width              = -1;
+        int  prefetch           = 8;
+        bool wrap               = true;
+        bool highlightSelection = true;
+        std::unordered_map<std::string,std::string> style = {};
+    };
+
+    /**
+     * @brief A scrolling list over a data source callback that only formats what is visible.
+     *
+     * Per-item row heights are measured the first time an item is laid out (by rendering it
+     * through the normal curses_wprint() wrapper into a scratch pad) and cached for the items
+     * around the view, so variable-height items near the view never need re-measuring. With wrap
+     * off every item is one row and nothing is cached, so memory never grows with the item count.
+     *
+     * render() keeps a record of which (item, line) is drawn on every row of the region and only
+     * redraws rows whose record changed, so moving the selection redraws two items and scrolling
+     * by one row redraws one row.
+     */
+    class ScrollList
+    {
+    public:
+        using ItemSource = std::function<std::string(size_t index)>;
+
+        /**
+         * @brief Called after an item has been rendered into the scratch pad and before it is
+         * copied to the window, to restyle cells in place (e.g. highlightSearchSpans()).
+         * `rows` is the number of pad rows the item occupies; `text` is what the source returned
+         * and `layout` is where it was printed in the pad, with each run's source offset located.
+         */
+        using ItemDecorator = std::function<void(WINDOW* pad, int rows, size_t index, const std::string& text,
+                                                 const PrintHelper::PrintLayout& layout)>;
+
+        ScrollList(WINDOW* window, size_t itemCount, ItemSource sourceParam, ScrollListSpec specParam = {})
+            : win(window)
+            , source(std::move(sourceParam))
+            , count(itemCount)
+            , spec(std::move(specParam))
+        {}
+
+        ~ScrollList()
+        {
+            if (pad) delwin(pad);
+        }
+
+        ScrollList(const ScrollList&) = delete;
+        ScrollList& operator=(const ScrollList&) = delete;
+
+        /**
+         * @brief Change the number of items in the data source (e.g. a log grew).
+         *
+         * Items below the old count keep their cached heights - appending to a log does not
+         * invalidate anything already on screen.
+         */
+        void setItemCount(size_t itemCount)
+        {
+            if (itemCount < count)
+            {
+                std::erase_if(formatted, [itemCount](const auto& entry) { return entry.first >= itemCount; });
+                std::erase_if(heights, [itemCount](const auto& entry) { return entry.first >= itemCount; });
+                markItemsDirtyFrom(itemCount);
+            }
+            count = itemCount;
+            if (count == 0)
+            {
+                topIndex = 0;
+                selectedIndex = 0;
+                return;
+            }
+            topIndex = std::min(topIndex, count - 1);
+            selectedIndex = std::min(selectedIndex, count - 1);
+        }
+
+        /**
+         * @brief Drop the cached text and height of one item so it is re-fetched on the next render().
+         */
+        void invalidate(size_t index)
+        {
+            if (index >= count) return;
+            formatted.erase(index);
+            heights.erase(index);
+            markItemDirty(index);
+        }
+
+        /**
+         * @brief Drop every cached item and force a full redraw of the region.
+         */
+        void invalidateAll()
+        {
+            formatted.clear();
+            heights.clear();
+            drawn.clear();
+        }
+
+        /**
+         * @brief Install (or clear, with nullptr) an ItemDecorator. Visible rows are redrawn.
+         */
+        void setItemDecorator(ItemDecorator decoratorParam)
+        {
+            decorator = std::move(decoratorParam);
+            redraw();
+        }
+
+        /**
+         * @brief Redraw every visible row on the next render() without re-fetching or re-measuring
+         * any item - for when only the decoration of items changed.
+         */
+        void redraw()
+        {
+            for (RowState& state : drawn) state.line = -1;
+            padItem = NO_ITEM;
+        }
+
+        /**
+         * @brief Move/resize the list's region inside its window (same meaning as the ScrollListSpec
+         * fields). Takes effect on the next render(); only a width change drops measured heights.
+         */
+        void setRegion(int top, int left, int height, int width)
+        {
+            spec.top    = top;
+            spec.left   = left;
+            spec.height = height;
+            spec.width  = width;
+        }
+
+        /**
+         * @brief Scroll the view by a number of items (negative scrolls up). Selection is unchanged.
+         */
+        void scrollBy(long delta)
+        {
+            if (count == 0) return;
+            long target = static_cast<long>(topIndex) + delta;
+            topIndex = static_cast<size_t>(std::clamp(target, 0L, static_cast<long>(count) - 1));
+        }
+
+        /**
+         * @brief Select an item and place it at the top of the view. O(1) in the item index.
+         */
+        void jumpTo(size_t index)
+        {
+            if (count == 0) return;
+            index = std::min(index, count - 1);
+            setSelected(index);
+            topIndex = index;
+        }
+
+        /**
+         * @brief Select an item, scrolling the minimum amount needed to keep it visible.
+         */
+        void select(size_t index)
+        {
+            if (count == 0) return;
+            index = std::min(index, count - 1);
+            setSelected(index);
+            ensureVisible(index);
+        }
+
+        /** @brief Move the selection by a number of items (negative moves up). */
+        void moveSelection(long delta)
+        {
+            if (count == 0) return;
+            long target = static_cast<long>(selectedIndex) + delta;
+            select(static_cast<size_t>(std::clamp(target, 0L, static_cast<long>(count) - 1)));
+        }
+
+        size_t selected() const { return selectedIndex; }
+        size_t top() const { return topIndex; }
+        size_t size() const { return count; }
+
+        /**
+         * @brief Number of items currently holding formatted text in the cache.
+         *
+         * Bounded by the visible slice plus 2 * spec.prefetch, independent of size().
+         */
+        size_t cachedItemCount() const { return formatted.size(); }
+
+        /**
+         * @brief Number of items with a cached row height. Bounded like cachedItemCount() (plus a
+         * region's height either side), and always 0 with wrap off.
+         */
+        size_t cachedHeightCount() const { return heights.size(); }
+
+        /**
+         * @brief Draw the list into its window. Only rows whose content changed are touched.
+         *
+         * Does not refresh the window - stage it with wnoutrefresh()/WindowManager::refreshAll()
+         * like any other print call.
+         */
+        void render()
+        {
+            if (!win) return;
+            resolveRegion();
+            if (rows <= 0 || cols <= 0) return;
+
+            if (drawn.size() != static_cast<size_t>(rows))
+            {
+                drawn.assign(rows, RowState{});
+            }
+            else if (topIndex != lastTop)
+            {
+                scrollDrawnRows();
+            }
+            lastTop = topIndex;
+
+            int row = 0;
+            size_t item = topIndex;
+            for (; item < count && row < rows; ++item)
+            {
+                int h = itemHeight(item);
+                int visibleLines = std::min(h, rows - row);
+
+                bool upToDate = true;
+                for (int line = 0; line < visibleLines; ++line)
+                {
+                    const RowState& state = drawn[row + line];
+                    if (state.item != item || state.line != line)
+                    {
+                        upToDate = false;
+                        break;
+                    }
+                }
+
+                if (!upToDate)
+                {
+                    if (padItem != item) renderToPad(item);
+                    copywin(pad, win, 0, 0,
+                            regionTop + row, regionLeft,
+                            regionTop + row + visibleLines - 1, regionLeft + cols - 1,
+                            FALSE);
+                    for (int line = 0; line < visibleLines; ++line)
+                    {
+                        drawn[row + line] = RowState{item, line};
+                    }
+                }
+                row += visibleLines;
+            }
+            lastVisible = (item > topIndex) ? item - 1 : topIndex;
+
+            // Anything below the last item is blank
+            for (; row < rows; ++row)
+            {
+                if (drawn[row].item == NO_ITEM && drawn[row].line == 0) continue;
+                mvwhline(win, regionTop + row, regionLeft, ' ', cols);
+                drawn[row] = RowState{NO_ITEM, 0};
+            }
+
+            prefetchAround();
+        }
+
+    private:
+        static constexpr size_t NO_ITEM = static_cast<size_t>(-1);
+
+        // What is currently drawn on a row of the region. A line of -1 marks a row whose contents
+        // are unknown and must be redrawn regardless (fresh region, or its item's selection state
+        // changed); {NO_ITEM, 0} marks a row known to be blank.
+        struct RowState
+        {
+            size_t item = NO_ITEM;
+            int    line = -1;
+        };
+
+        WINDOW*        win;
+        ItemSource     source;
+        ItemDecorator  decorator;
+        size_t         count;
+        ScrollListSpec spec;
+
+        size_t topIndex      = 0;
+        size_t selectedIndex = 0;
+        size_t lastTop       = 0;
+        size_t lastVisible   = 0;
+
+        std::unordered_map<size_t, uint16_t>    heights;   // measured items around the view (wrap only)
+        std::unordered_map<size_t, std::string> formatted; // visible slice + prefetch margin
+        std::vector<RowState>                   drawn;     // one entry per region row
+
+        // Resolved region, recomputed from the window size on every render()
+        int regionTop  = 0;
+        int regionLeft = 0;
+        int rows       = 0;
+        int cols       = 0;
+
+        // Scratch pad items are rendered into before being copied to the window. Rendering through
+        // curses_wprint() here means measured heights always match the real wrapping exactly.
+        WINDOW* pad     = nullptr;
+        size_t  padItem = NO_ITEM;
+
+        void resolveRegion()
+        {
+            int winHeight, winWidth;
+            getmaxyx(win, winHeight, winWidth);
+            int newTop  = std::clamp(spec.top, 0, winHeight);
+            int newLeft = std::clamp(spec.left, 0, winWidth);
+            int newRows = spec.height < 0 ? winHeight - newTop : std::min(spec.height, winHeight - newTop);
+            int newCols = spec.width  < 0 ? winWidth - newLeft : std::min(spec.width, winWidth - newLeft);
+
+            if (newCols != cols)
+            {
+                // Wrapping depends on the width - every measured height is stale
+                heights.clear();
+                drawn.clear();
+                if (pad) delwin(pad);
+                pad = nullptr;
+                padItem = NO_ITEM;
+            }
+            else if (newTop != regionTop || newLeft != regionLeft || newRows != rows)
+            {
+                drawn.clear();
+            }
+
+            regionTop  = newTop;
+            regionLeft = newLeft;
+            rows       = newRows;
+            cols       = newCols;
+        }
+
+        const std::string& itemText(size_t index)
+        {
+            auto it = formatted.find(index);
+            if (it == formatted.end())
+            {
+                it = formatted.emplace(index, source(index)).first;
+            }
+            return it->second;
+        }
+
+        int itemHeight(size_t index)
+        {
+            if (!spec.wrap) return 1;
+            auto it = heights.find(index);
+            if (it != heights.end()) return it->second;
+            return renderToPad(index);
+        }
+
+        /** Render an item into the scratch pad; returns its height in rows. */
+        int renderToPad(size_t index)
+        {
+            if (!pad) pad = newpad(std::max(rows, 1), std::max(cols, 1));
+            else if (getmaxy(pad) < rows) wresize(pad, rows, cols);
+
+            bool highlighted = spec.highlightSelection && index == selectedIndex;
+            wbkgdset(pad, highlighted ? (' ' | A_REVERSE) : ' ');
+            werase(pad);
+
+            std::string text = itemText(index);
+            std::unordered_map<std::string,std::string> format = {};
+            if (spec.wrap) format["wrap"] = "true";
+            PrintHelper::PrintLayout layout = PrintHelper::layoutPrint(getmaxy(pad), getmaxx(pad), 0, 0, text,
+                                                                       spec.style, format, textStyling);
+            PrintHelper::curses_wprintLayout(pad, layout);
+
+            int height = spec.wrap ? std::clamp(getcury(pad) + 1, 1, std::max(rows, 1)) : 1;
+            if (spec.wrap) heights[index] = static_cast<uint16_t>(height);
+            if (decorator)
+            {
+                PrintHelper::locatePrintRuns(text, layout);
+                decorator(pad, height, index, text, layout);
+            }
+            wbkgdset(pad, ' ');
+            padItem = index;
+            return height;
+        }
+
+        void setSelected(size_t index)
+        {
+            if (index == selectedIndex) return;
+            markItemDirty(selectedIndex);
+            markItemDirty(index);
+            if (padItem == selectedIndex || padItem == index) padItem = NO_ITEM;
+            selectedIndex = index;
+        }
+
+        void markItemDirty(size_t index)
+        {
+            for (RowState& state : drawn)
+            {
+                if (state.item == index) state.line = -1;
+            }
+        }
+
+        void markItemsDirtyFrom(size_t index)
+        {
+            for (RowState& state : drawn)
+            {
+                if (state.item != NO_ITEM && state.item >= index) state.line = -1;
+            }
+        }
+
+        void ensureVisible(size_t index)
+        {
+            if (index < topIndex)
+            {
+                topIndex = index;
+                return;
+            }
+            if (rows <= 0) return;
+
+            // Walk back from the item until the rows above it are filled - bounded by the region
+            // height, not by the index.
+            int used = itemHeight(index);
+            size_t newTop = index;
+            while (newTop > topIndex)
+            {
+                int h = itemHeight(newTop - 1);
+                if (used + h > rows) break;
+                used += h;
+                --newTop;
+            }
+            topIndex = std::max(topIndex, newTop);
+        }
+
+        /**
+         * The top item changed since the last render. Shift the drawn-row record (and, when the
+         * region spans the whole window width, the window contents themselves via wscrl()) by the
+         * number of rows scrolled, so that rows which merely moved are not redrawn.
+         */
+        void scrollDrawnRows()
+        {
+            size_t lo = std::min(topIndex, lastTop);
+            size_t hi = std::max(topIndex, lastTop);
+            if (hi - lo >= static_cast<size_t>(rows))
+            {
+                drawn.assign(rows, RowState{});
+                return;
+            }
+
+            int shift = 0;
+            for (size_t i = lo; i < hi; ++i) shift += itemHeight(i);
+            if (shift >= rows)
+            {
+                drawn.assign(rows, RowState{});
+                return;
+            }
+            if (topIndex < lastTop) shift = -shift;
+
+            std::vector<RowState> shifted(rows);
+            for (int r = 0; r < rows; ++r)
+            {
+                int from = r + shift;
+                if (from >= 0 && from < rows) shifted[r] = drawn[from];
+            }
+
+            if (regionLeft == 0 && cols == getmaxx(win))
+            {
+                // Scroll just the region, then put back the caller's scroll region and setting
+                int callerTop = 0, callerBottom = 0;
+                wgetscrreg(win, &callerTop, &callerBottom);
+                bool callerScrollok = is_scrollok(win);
+                wsetscrreg(win, regionTop, regionTop + rows - 1);
+                scrollok(win, TRUE);
+                wscrl(win, shift);
+                scrollok(win, callerScrollok);
+                wsetscrreg(win, callerTop, callerBottom);
+                drawn = std::move(shifted);
+            }
+            else
+            {
+                // Window can't be scrolled without disturbing columns outside the region - every
+                // row has to be redrawn, but the heights measured above are still reused.
+                drawn.assign(rows, RowState{});
+            }
+        }
+
+        /**
+         * Format the prefetch margin around the visible slice and evict everything else, so the
+         * caches stay bounded by the view size rather than the collection size. Heights are kept a
+         * region's height further either side, which covers everything ensureVisible() and
+         * scrollDrawnRows() measure.
+         */
+        void prefetchAround()
+        {
+            if (count == 0) return;
+            size_t margin = static_cast<size_t>(std::max(spec.prefetch, 0));
+            size_t lo = topIndex > margin ? topIndex - margin : 0;
+            size_t hi = std::min(count - 1, lastVisible + margin);
+
+            for (auto it = formatted.begin(); it != formatted.end(); )
+            {
+                if (it->first < lo || it->first > hi) it = formatted.erase(it);
+                else ++it;
+            }
+            for (size_t i = lo; i <= hi; ++i) itemText(i);
+
+            const size_t reach = static_cast<size_t>(std::max(rows, 0));
+            const size_t heightLo = lo > reach ? lo - reach : 0;
+            const size_t heightHi = hi + reach;
+            std::erase_if(heights, [heightLo, heightHi](const auto& entry) {
+                return entry.first < heightLo || entry.first > heightHi;
+            });
+        }
+    };
+
+} // namespace stevensTerminal
@@ -0,0 +1,273 @@
+#pragma once
+/**
+ * @file Sparkline.hpp
+ * @brief Live time-series widget: a fixed-capacity history drawn as a sparkline.
+ *
+ * Samples go into a ring buffer, and each one is also folded into the min/max of the screen
+ * column it falls in, so push() is O(1) and draw() is O(width x height) however much history
+ * is kept. Each column covers a fixed run of consecutive samples and shows their whole range,
+ * so a one-frame spike still shows up after downsampling.
+ *
+ * Braille style plots each column's min-max range as dots, two columns per cell and four dot
+ * rows per cell row. Eighths style draws each column's maximum as a bar with an eighth-block
+ * top (through a Histogram).
+ *
+ * Usage:
+ *   stevensTerminal::Sparkline frameTimes(3600, 40, 3);   // a minute at 60 fps, 40 cells x 3 rows
+ *   // every frame:
+ *   frameTimes.push(frameMs);
+ *   frameTimes.draw(statsWin, 1, 2);
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <vector>
+#include "Colors.hpp"
+#include "Chart.hpp"
+
+namespace stevensTerminal
+{
+    class Sparkline
+    {
+    public:
+        enum class Style { Braille, Eighths };
+
+        /**
+         * @param capacity Samples of history kept
+         * @param width    Cells across
+         * @param height   Rows
+         * @param style    Braille (two columns per cell) or Eighths (one bar per cell)
+         * @param color    Line colour name
+         * @param bgColor  Background colour name
+         */
+        Sparkline(size_t capacity, int width, int height = 1, Style style = Style::Braille,
+                  const std::string& color = "green", const std::string& bgColor = "black")
+            : history(std::max<size_t>(capacity, 1))
+            , height(std::max(height, 1))
+            , style(style)
+            , attr(COLOR_PAIR(Colors::lookupColorPairByName(color, bgColor)))
+            , bars(std::max(height, 1), 1, 0, color, bgColor)
+        {
+            setWidth(width);
+        }
+
+        /**
+         * @brief Append a sample, dropping the oldest once the history is full. O(1).
+         */
+        void push(float value)
+        {
+            history[head] = value;
+            head = (head + 1) % history.size();
+            count = std::min(count + 1, history.size());
+
+            const uint64_t bucket = pushed / samplesPerColumn;
+            Column& column = columns[bucket % columns.size()];
+            if (pushed % samplesPerColumn == 0)
+            {
+                column.low = column.high = value;
+            }
+            else
+            {
+                column.low = std::min(column.low, value);
+                column.high = std::max(column.high, value);
+            }
+            ++pushed;
+        }
+
+        size_t size() const { return count; }
+        size_t capacity() const { return history.size(); }
+
+        /** @brief Sample `age` pushes ago (0 = the latest). age must be < size(). */
+        float recent(size_t age = 0) const
+        {
+            return history[(head + history.size() - 1 - age) % history.size()];
+        }
+
+        /**
+         * @brief Resize to `width` cells, re-bucketing the kept history. O(capacity).
+         */
+        void setWidth(int cells)
+        {
+            width = std::max(cells, 1);
+            const size_t columnCount = static_cast<size_t>(width) * (style == Style::Braille ? 2 : 1);
+            samplesPerColumn = std::max<uint64_t>(1, (history.size() + columnCount - 1) / columnCount);
+            columns.assign(columnCount, Column{});
+            scratch.resize(columnCount);
+            lowDots.resize(columnCount);
+            highDots.resize(columnCount);
+
+            // Fold the kept samples back into the new columns, one contiguous run at a time
+            const uint64_t oldest = pushed - count;
+            for (uint64_t start = oldest; start < pushed; )
+            {
+                const uint64_t bucket = start / samplesPerColumn;
+                const uint64_t end = std::min(pushed, (bucket + 1) * samplesPerColumn);
+                Column& column = columns[bucket % columns.size()];
+                column.low = std::numeric_limits<float>::max();
+                column.high = std::numeric_limits<float>::lowest();
+                for (uint64_t sample = start; sample < end; )
+                {
+                    // The run may wrap around the end of the ring buffer
+                    const size_t slot = sample % history.size();
+                    const size_t run = std::min<uint64_t>(end - sample, history.size() - slot);
+                    minMax(history.data() + slot, run, column.low, column.high);
+                    sample += run;
+                }
+                start = end;
+            }
+            bars.invalidate();
+        }
+
+        /** @brief Fix the vertical scale instead of fitting it to the visible samples. */
+        void setRange(float low, float high)
+        {
+            fixedRange = high > low;
+            rangeLow = low;
+            rangeHigh = high;
+        }
+
+        void setAutoRange() { fixedRange = false; }
+
+        /**
+         * @brief Draw the most recent history at (y, x), newest on the right
+         */
+        void draw(WINDOW* win, int y, int x)
+        {
+            if (!win) return;
+
+            // The last `visible` columns, oldest first: only buckets holding a kept sample, so
+            // evicted history (and columns setWidth() never refilled) stays off screen
+            const uint64_t started = pushed == 0 ? 0 : (pushed - 1) / samplesPerColumn + 1;
+            const uint64_t oldestKept = (pushed - count) / samplesPerColumn;
+            const size_t visible = count == 0 ? 0
+                : static_cast<size_t>(std::min<uint64_t>(started - oldestKept, columns.size()));
+            const size_t blank = columns.size() - visible;
+            float low = std::numeric_limits<float>::max();
+            float high = std::numeric_limits<float>::lowest();
+            for (size_t i = 0; i < visible; ++i)
+            {
+                const Column& column = columns[(started - visible + i) % columns.size()];
+                low = std::min(low, column.low);
+                high = std::max(high, column.high);
+            }
+            if (fixedRange)
+            {
+                low = rangeLow;
+                high = rangeHigh;
+            }
+            if (!(high > low)) high = low + 1.0f;
+
+            if (style == Style::Eighths)
+            {
+                for (size_t i = 0; i < columns.size(); ++i)
+                {
+                    scratch[i] = i < blank ? 0.0f
+                               : columns[(started - visible + (i - blank)) % columns.size()].high - low;
+                }
+                bars.draw(win, y, x, scratch, high - low);
+                return;
+            }
+
+            // Braille: each column lights the dots spanning its min-max range
+            const int dotRows = height * 4;
+            auto dotOf = [&](float value) {
+                float fraction = std::clamp((value - low) / (high - low), 0.0f, 1.0f);
+                return static_cast<int>(std::lround(fraction * (dotRows - 1)));   // 0 = bottom
+            };
+            for (size_t i = 0; i < columns.size(); ++i)
+            {
+                if (i < blank)
+                {
+                    lowDots[i] = 1;    // empty range: nothing lit
+                    highDots[i] = 0;
+                    continue;
+                }
+                const Column& column = columns[(started - visible + (i - blank)) % columns.size()];
+                lowDots[i] = dotOf(column.low);
+                highDots[i] = dotOf(column.high);
+            }
+
+            wattron(win, attr);
+            char glyph[4] = {'\xE2', 0, 0, 0};
+            for (int row = 0; row < height; ++row)
+            {
+                const int rowBottom = (height - 1 - row) * 4;   // dot index of the cell's bottom row
+                wmove(win, y + row, x);
+                for (int cell = 0; cell < width; ++cell)
+                {
+                    unsigned bits = cellDots(2 * cell, rowBottom, 0) | cellDots(2 * cell + 1, rowBottom, 3);
+                    if (bits == 0)
+                    {
+                        waddch(win, ' ');
+                        continue;
+                    }
+                    glyph[1] = static_cast<char>(0xA0 | (bits >> 6));
+                    glyph[2] = static_cast<char>(0x80 | (bits & 0x3F));
+                    waddnstr(win, glyph, 3);
+                }
+            }
+            wattroff(win, attr);
+        }
+
+        /**
+         * @brief Widen [low, high] to cover values[0, count). Branch-free, so it vectorizes.
+         */
+        static void minMax(const float* values, size_t count, float& low, float& high)
+        {
+            float lo = low, hi = high;
+            for (size_t i = 0; i < count; ++i)
+            {
+                lo = values[i] < lo ? values[i] : lo;
+                hi = values[i] > hi ? values[i] : hi;
+            }
+            low = lo;
+            high = hi;
+        }
+
+    private:
+        struct Column
+        {
+            float low = 0.0f;
+            float high = 0.0f;
+        };
+
+        std::vector<float>  history;           // ring buffer of samples
+        size_t              head = 0;          // slot the next sample goes in
+        size_t              count = 0;
+        uint64_t            pushed = 0;        // samples ever pushed; sample n is in column n / samplesPerColumn
+        uint64_t            samplesPerColumn = 1;
+        std::vector<Column> columns;           // ring of per-column ranges, indexed by column % size
+        std::vector<float>  scratch;           // per-column values handed to the Histogram
+        std::vector<int>    lowDots, highDots;
+
+        int                 width = 1;
+        int                 height;
+        Style               style;
+        attr_t              attr;
+        Histogram           bars;
+        bool                fixedRange = false;
+        float               rangeLow = 0.0f, rangeHigh = 1.0f;
+
+        /**
+         * Braille bits for one column within the cell whose bottom dot row is rowBottom. The left
+         * column's dots are bits 0-2 and 6 (top to bottom), the right column's are bits 3-5 and 7;
+         * `shift` is 0 or 3 to pick the column.
+         */
+        unsigned cellDots(int columnIndex, int rowBottom, int shift) const
+        {
+            unsigned bits = 0;
+            for (int dot = 0; dot < 4; ++dot)
+            {
+                const int level = rowBottom + (3 - dot);   // dot 0 is the cell's top row
+                if (level < lowDots[columnIndex] || level > highDots[columnIndex]) continue;
+                bits |= dot == 3 ? (shift ? 0x80u : 0x40u) : (1u << (dot + shift));
+            }
+            return bits;
+        }
+    };
+
+} // namespace stevensTerminal
@@ -4,9 +4,12 @@
  * @brief Animated spinner (loading indicator) utilities for stevensTerminal.
  */
 
+#include <algorithm>
+#include <cstdint>
 #include <string>
 #include <vector>
 #include "Colors.hpp"
+#include "TimerWheel.hpp"
 
 #if defined(__linux__)
     #include <ncurses.h>
@@ -42,8 +45,8 @@ namespace stevensTerminal
     /**
      * @brief Render one frame of a spinner animation into a curses window.
      *
-     * Advance `frame` by 1 each tick (e.g. via an atomic counter in an animation
-     * thread) and call this on the main thread to show the current frame.
+     * Advance `frame` by 1 each tick and call this on the main thread to show the
+     * current frame, or let animateSpinner() keep the counter on a TimerWheel.
      *
      * @param win    The curses window to render into.
      * @param y      Row in the window (0-based).
@@ -69,6 +72,27 @@ namespace stevensTerminal
         wattroff(win, attrs);
     }
 
+    /**
+     * @brief Animate a spinner at (y, x) from a TimerWheel: frame 0 is drawn now and the next frame
+     * every periodMs as the wheel is serviced. Cancel the returned id to stop it.
+     *
+     * Frames are drawn into win only; refresh it from your frame loop as usual. win must outlive
+     * the timer.
+     */
+    inline TimerWheel::Id animateSpinner(TimerWheel&        timers,
+                                         WINDOW*            win,
+                                         int                y,
+                                         int                x,
+                                         const SpinnerSpec& spec = {},
+                                         int                periodMs = 120)
+    {
+        printSpinner(win, y, x, 0, spec);
+        return timers.every(static_cast<uint64_t>(std::max(periodMs, 1)), [win, y, x, spec](uint64_t period) {
+            if (spec.frames.empty()) return;
+            printSpinner(win, y, x, static_cast<int>(period % spec.frames.size()), spec);
+        });
+    }
+
     /** Ready-made SpinnerSpec presets. Pass one as the last arg to printSpinner(). */
     namespace spinners
     {
@@ -0,0 +1,424 @@
+#pragma once
+/**
+ * @file TextSearch.hpp
+ * @brief Fast, cancellable background substring search over viewer/list data sources.
+ *
+ * Matches are reported as (line, byte column, byte length) so a renderer can highlight them by
+ * restyling the attributes of cells already on screen, found through the layout the line was
+ * printed from (see highlightSearchSpans()), instead of re-tokenizing the text with extra style
+ * markup.
+ *
+ * Usage:
+ *   stevensTerminal::TextSearch search;
+ *   search.start(mappedFile.view(), "ERROR");     // returns immediately
+ *   ...each frame...
+ *   for (const SearchMatch& m : search.takeNewMatches()) { ... }
+ *   if (search.isDone()) { ... }
+ */
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Core.hpp"
+
+namespace stevensTerminal
+{
+    /**
+     * @brief A substring searcher with its needle preprocessed once.
+     *
+     * Needles of up to 3 bytes use memchr() (SIMD-accelerated in every mainstream libc) to jump to
+     * candidate first bytes and memcmp() to confirm. Longer needles use Boyer-Moore-Horspool, whose
+     * skip table lets it step over most of the haystack without looking at it.
+     */
+    class SubstringFinder
+    {
+    public:
+        static constexpr size_t MEMCHR_MAX_NEEDLE = 3;
+
+        explicit SubstringFinder(std::string needleParam = "")
+            : needle(std::move(needleParam))
+        {
+            skip.fill(needle.size());
+            if (needle.size() > MEMCHR_MAX_NEEDLE)
+            {
+                for (size_t i = 0; i + 1 < needle.size(); ++i)
+                {
+                    skip[static_cast<unsigned char>(needle[i])] = needle.size() - 1 - i;
+                }
+            }
+        }
+
+        const std::string& pattern() const { return needle; }
+
+        /**
+         * @brief Position of the first occurrence of the needle in haystack at or after `from`.
+         * @return std::string::npos if there is none (or the needle is empty).
+         */
+        size_t find(std::string_view haystack, size_t from = 0) const
+        {
+            const size_t n = needle.size();
+            if (n == 0 || from >= haystack.size() || haystack.size() - from < n) return std::string::npos;
+
+            const char* base = haystack.data();
+            const char* end  = base + haystack.size();
+
+            if (n <= MEMCHR_MAX_NEEDLE)
+            {
+                const char* pos = base + from;
+                while (static_cast<size_t>(end - pos) >= n)
+                {
+                    const void* hit = std::memchr(pos, needle[0], static_cast<size_t>(end - pos) - n + 1);
+                    if (!hit) return std::string::npos;
+                    const char* candidate = static_cast<const char*>(hit);
+                    if (std::memcmp(candidate + 1, needle.data() + 1, n - 1) == 0)
+                        return static_cast<size_t>(candidate - base);
+                    pos = candidate + 1;
+                }
+                return std::string::npos;
+            }
+
+            // Boyer-Moore-Horspool
+            const unsigned char last = static_cast<unsigned char>(needle[n - 1]);
+            size_t pos = from;
+            while (pos + n <= haystack.size())
+            {
+                unsigned char tail = static_cast<unsigned char>(base[pos + n - 1]);
+                if (tail == last && std::memcmp(base + pos, needle.data(), n - 1) == 0) return pos;
+                pos += skip[tail];
+            }
+            return std::string::npos;
+        }
+
+    private:
+        std::string              needle;
+        std::array<size_t, 256>  skip;
+    };
+
+
+    /**
+     * @brief One search hit: a byte span within a line.
+     */
+    struct SearchMatch
+    {
+        size_t line;    // 0-based line / list item index
+        size_t column;  // byte offset of the match within the line
+        size_t length;  // byte length of the match
+    };
+
+
+    /**
+     * @brief Incremental, cancellable substring search on a worker thread.
+     *
+     * Results accumulate as the worker finds them; poll takeNewMatches() from the render loop.
+     * Starting a new search (or destroying the object) cancels the one in flight.
+     */
+    class TextSearch
+    {
+    public:
+        using LineSource = std::function<std::string(size_t line)>;
+
+        static constexpr size_t CHUNK_BYTES = 1 << 20; // cancellation/progress granularity
+
+        TextSearch() = default;
+        ~TextSearch() { cancel(); }
+
+        TextSearch(const TextSearch&) = delete;
+        TextSearch& operator=(const TextSearch&) = delete;
+
+        /**
+         * @brief Search a contiguous block of text (e.g. MappedFile::view()) line by line.
+         *
+         * The buffer must outlive the search.
+         */
+        void start(std::string_view buffer, std::string needle, size_t maxMatchesParam = 100000)
+        {
+            begin(std::move(needle), maxMatchesParam, buffer.size());
+            worker = std::thread([this, buffer] { searchBuffer(buffer); });
+        }
+
+        /**
+         * @brief Search a line-oriented data source (e.g. a ScrollList's ItemSource).
+         *
+         * `source` is called from the worker thread, so it must be safe to call concurrently with
+         * whatever else the caller does to the underlying collection.
+         */
+        void start(size_t lineCount, LineSource source, std::string needle, size_t maxMatchesParam = 100000)
+        {
+            begin(std::move(needle), maxMatchesParam, lineCount);
+            worker = std::thread([this, lineCount, source = std::move(source)] { searchLines(lineCount, source); });
+        }
+
+        /** @brief Stop the search in flight (if any) and wait for the worker to exit. */
+        void cancel()
+        {
+            cancelled.store(true, std::memory_order_relaxed);
+            if (worker.joinable()) worker.join();
+        }
+
+        bool isDone() const { return done.load(std::memory_order_acquire); }
+
+        /** @brief Fraction of the input searched so far, 0.0 - 1.0. */
+        double progress() const
+        {
+            size_t total = workTotal.load(std::memory_order_relaxed);
+            if (total == 0) return isDone() ? 1.0 : 0.0;
+            return static_cast<double>(workDone.load(std::memory_order_relaxed)) / static_cast<double>(total);
+        }
+
+        /** @brief Total matches found so far (capped at the maxMatches passed to start()). */
+        size_t matchCount() const { return found.load(std::memory_order_relaxed); }
+
+        /** @brief Matches found since the last call, in document order. */
+        std::vector<SearchMatch> takeNewMatches()
+        {
+            std::lock_guard<std::mutex> lock(resultMutex);
+            std::vector<SearchMatch> result;
+            result.swap(pending);
+            return result;
+        }
+
+    private:
+        SubstringFinder          finder;
+        size_t                   maxMatches = 0;
+        std::thread              worker;
+        std::atomic<bool>        cancelled{false};
+        std::atomic<bool>        done{false};
+        std::atomic<size_t>      workDone{0};
+        std::atomic<size_t>      workTotal{0};
+        std::atomic<size_t>      found{0};
+        std::mutex               resultMutex;
+        std::vector<SearchMatch> pending;
+
+        void begin(std::string needle, size_t maxMatchesParam, size_t total)
+        {
+            cancel();
+            finder = SubstringFinder(std::move(needle));
+            maxMatches = maxMatchesParam;
+            cancelled.store(false, std::memory_order_relaxed);
+            done.store(false, std::memory_order_relaxed);
+            workDone.store(0, std::memory_order_relaxed);
+            workTotal.store(total, std::memory_order_relaxed);
+            found.store(0, std::memory_order_relaxed);
+            std::lock_guard<std::mutex> lock(resultMutex);
+            pending.clear();
+        }
+
+        bool publish(std::vector<SearchMatch>& batch)
+        {
+            if (!batch.empty())
+            {
+                std::lock_guard<std::mutex> lock(resultMutex);
+                pending.insert(pending.end(), batch.begin(), batch.end());
+                batch.clear();
+            }
+            return found.load(std::memory_order_relaxed) < maxMatches;
+        }
+
+        void searchBuffer(std::string_view buffer)
+        {
+            std::vector<SearchMatch> batch;
+            size_t line      = 0; // line number at lineStart
+            size_t lineStart = 0; // byte offset of that line
+            size_t counted   = 0; // newlines before this offset have been counted
+            size_t pos       = 0;
+            const size_t n   = finder.pattern().size();
+
+            while (pos < buffer.size() && !cancelled.load(std::memory_order_relaxed))
+            {
+                // Search one chunk at a time (overlapping by n-1 bytes so no match straddles a
+                // boundary unseen) so cancel() and progress() stay responsive on huge files.
+                size_t chunkEnd = std::min(buffer.size(), pos + CHUNK_BYTES + (n ? n - 1 : 0));
+                std::string_view chunk = buffer.substr(0, chunkEnd);
+
+                size_t hit = finder.find(chunk, pos);
+                while (hit != std::string::npos)
+                {
+                    // Advance the line count to the hit. memchr() keeps this vectorized, and every
+                    // byte is only ever counted once across the whole search.
+                    while (true)
+                    {
+                        const void* nl = std::memchr(buffer.data() + counted, '\n', hit - counted);
+                        if (!nl) break;
+                        counted = static_cast<size_t>(static_cast<const char*>(nl) - buffer.data()) + 1;
+                        lineStart = counted;
+                        ++line;
+                    }
+                    counted = hit;
+
+                    // Matches spanning a newline aren't line matches
+                    if (!std::memchr(buffer.data() + hit, '\n', n))
+                    {
+                        batch.push_back(SearchMatch{line, hit - lineStart, n});
+                        if (found.fetch_add(1, std::memory_order_relaxed) + 1 >= maxMatches)
+                        {
+                            publish(batch);
+                            workDone.store(buffer.size(), std::memory_order_relaxed);
+                            done.store(true, std::memory_order_release);
+                            return;
+                        }
+                    }
+                    hit = finder.find(chunk, hit + 1);
+                }
+
+                pos = std::min(buffer.size(), pos + CHUNK_BYTES);
+                workDone.store(pos, std::memory_order_relaxed);
+                publish(batch);
+            }
+            publish(batch);
+            done.store(true, std::memory_order_release);
+        }
+
+        void searchLines(size_t lineCount, const LineSource& source)
+        {
+            std::vector<SearchMatch> batch;
+            for (size_t line = 0; line < lineCount && !cancelled.load(std::memory_order_relaxed); ++line)
+            {
+                std::string text = source(line);
+                size_t hit = finder.find(text);
+                while (hit != std::string::npos)
+                {
+                    batch.push_back(SearchMatch{line, hit, finder.pattern().size()});
+                    if (found.fetch_add(1, std::memory_order_relaxed) + 1 >= maxMatches)
+                    {
+                        publish(batch);
+                        done.store(true, std::memory_order_release);
+                        return;
+                    }
+                    hit = finder.find(text, hit + 1);
+                }
+                workDone.store(line + 1, std::memory_order_relaxed);
+                if ((line & 1023) == 1023) publish(batch);
+            }
+            publish(batch);
+            done.store(true, std::memory_order_release);
+        }
+    };
+
+
+    /**
+     * @brief Highlight byte spans of a line that has already been rendered into `win`.
+     *
+     * `layout` is the layout the line was printed from, with its runs located in the line (see
+     * PrintHelper::locatePrintRuns() - ScrollList's ItemDecorator gets one). Each run is walked
+     * the way curses printed it - tabs to the next stop, wide glyphs over two cells, wrapping at
+     * the window's edge - so spans land on the right cells even when the displayed text differs
+     * from the source (style markup, tabs). Cells inside a span get `attr` OR'd onto their
+     * existing attributes (colour pair kept) via wchgat(), so nothing is re-tokenized or re-wrapped.
+     *
+     * @param win    Window or pad the line was rendered into.
+     * @param layout Where the line was printed, with PrintRun::source filled in.
+     * @param spans  (byte column, byte length) spans of the line to highlight.
+     * @param attr   Attribute(s) to add, A_REVERSE by default.
+     */
+    inline void highlightSearchSpans(WINDOW* win,
+                                     const PrintHelper::PrintLayout& layout,
+                                     const std::vector<std::pair<size_t,size_t>>& spans,
+                                     chtype attr = A_REVERSE)
+    {
+        if (!win || spans.empty()) return;
+        const int width = getmaxx(win);
+        const int height = getmaxy(win);
+        if (width <= 0) return;
+        auto highlighted = [&](size_t offset) {
+            for (const auto& [column, length] : spans)
+            {
+                if (offset >= column && offset < column + length) return true;
+            }
+            return false;
+        };
+        auto highlight = [&](int y, int x, int cells) {
+            for (int c = 0; c < cells && x + c < width; ++c)
+            {
+                chtype existing = mvwinch(win, y, x + c);
+                attr_t attrs = (existing & A_ATTRIBUTES & ~A_COLOR) | attr;
+                mvwchgat(win, y, x + c, 1, attrs, static_cast<short>(PAIR_NUMBER(existing)), nullptr);
+            }
+        };
+
+        int y = 0, x = 0;
+        for (const PrintHelper::PrintRun& run : layout.runs)
+        {
+            if (!run.atCursor)
+            {
+                y = run.y;
+                x = run.x;
+            }
+            const std::string& text = run.text;
+            for (size_t i = 0; i < text.size() && y < height; )
+            {
+                unsigned char lead = static_cast<unsigned char>(text[i]);
+                size_t length = lead < 0x80 ? 1 : (lead & 0xE0) == 0xC0 ? 2 : (lead & 0xF0) == 0xE0 ? 3
+                              : (lead & 0xF8) == 0xF0 ? 4 : 1;
+                length = std::min(length, text.size() - i);
+                bool lit = run.source != std::string::npos && highlighted(run.source + i);
+                i += length;
+
+                if (lead == '\n')
+                {
+                    ++y;
+                    x = 0;
+                    continue;
+                }
+                int cells = lead == '\t' ? 8 - x % 8
+                          : lead < 0x20 || lead == 0x7F ? 2   // shown as ^X
+                          : lead < 0x80 ? 1
+                          : static_cast<int>(stevensStringLib::lineDisplayWidth(text.substr(i - length, length)));
+                if (cells == 2 && lead >= 0x80 && x + 2 > width)
+                {
+                    ++y;    // a wide glyph that doesn't fit goes to the next row
+                    x = 0;
+                }
+                if (lit && y < height) highlight(y, x, cells);
+                x += cells;
+                while (x >= width)
+                {
+                    ++y;
+                    x -= width;
+                }
+            }
+        }
+    }
+
+
+    /**
+     * @brief Search matches grouped by line, ready to be drawn by highlightSearchSpans().
+     */
+    class SearchHighlights
+    {
+    public:
+        void clear() { spansByLine.clear(); }
+
+        void add(const std::vector<SearchMatch>& matches)
+        {
+            for (const SearchMatch& match : matches)
+            {
+                spansByLine[match.line].emplace_back(match.column, match.length);
+            }
+        }
+
+        bool empty() const { return spansByLine.empty(); }
+
+        bool hasLine(size_t line) const { return spansByLine.contains(line); }
+
+        /** @brief Highlight this line's matches, if any, in a rendered copy of the line. */
+        void apply(WINDOW* win, size_t line, const PrintHelper::PrintLayout& layout, chtype attr = A_REVERSE) const
+        {
+            auto it = spansByLine.find(line);
+            if (it == spansByLine.end()) return;
+            highlightSearchSpans(win, layout, it->second, attr);
+        }
+
+    private:
+        std::unordered_map<size_t, std::vector<std::pair<size_t,size_t>>> spansByLine;
+    };
+
+} // namespace stevensTerminal
@@ -0,0 +1,225 @@
+#pragma once
+/**
+ * @file ThreadPool.hpp
+ * @brief Small work-stealing thread pool shared by the library's parallel paths.
+ *
+ * Each worker owns a task deque: it pops its own work from the back (most recently pushed, still
+ * warm in cache) and, when that runs dry, steals from the front of the other workers' deques.
+ * parallelFor() also puts the calling thread to work, so it can be nested or called from inside
+ * a task without deadlocking.
+ *
+ * No curses calls may be made from pool threads - ncurses is not thread-safe. Parallel stages
+ * produce plain data (cell buffers, particle arrays) that a serial stage then hands to curses.
+ *
+ * Usage:
+ *   stevensTerminal::defaultThreadPool().parallelFor(panes.size(), [&](size_t i) {
+ *       rasterize(panes[i]);
+ *   });
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace stevensTerminal
+{
+    class ThreadPool
+    {
+    public:
+        /**
+         * @param threadCount Worker threads to start. The default leaves one hardware thread for
+         *                    the caller, which also runs tasks inside parallelFor().
+         */
+        explicit ThreadPool(size_t threadCount = defaultThreadCount())
+        {
+            threadCount = std::max<size_t>(threadCount, 1);
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                queues.push_back(std::make_unique<TaskQueue>());
+            }
+            for (size_t i = 0; i < threadCount; ++i)
+            {
+                workers.emplace_back([this, i] { workerLoop(i); });
+            }
+        }
+
+        ~ThreadPool()
+        {
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                stopping = true;
+            }
+            wake.notify_all();
+            for (std::thread& worker : workers) worker.join();
+        }
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+
+        static size_t defaultThreadCount()
+        {
+            unsigned hardware = std::thread::hardware_concurrency();
+            return hardware > 1 ? hardware - 1 : 1;
+        }
+
+        size_t threadCount() const { return workers.size(); }
+
+        /**
+         * @brief Queue a task. It must not throw.
+         */
+        void submit(std::function<void()> task)
+        {
+            size_t target = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+            {
+                // Counted before it's visible, so a thief can never take it before it's counted
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                ++queued;
+            }
+            {
+                std::lock_guard<std::mutex> lock(queues[target]->mutex);
+                queues[target]->tasks.push_back(std::move(task));
+            }
+            wake.notify_one();
+        }
+
+        /**
+         * @brief Run body(i) for every i in [0, count) across the pool and the calling thread,
+         * returning once all have finished.
+         *
+         * Indices are handed out in chunks of `grain`. If any call throws, the first exception is
+         * rethrown here after the remaining calls have finished.
+         */
+        void parallelFor(size_t count, const std::function<void(size_t)>& body, size_t grain = 1)
+        {
+            if (count == 0) return;
+            grain = std::max<size_t>(grain, 1);
+            size_t chunks = (count + grain - 1) / grain;
+            if (chunks == 1)
+            {
+                for (size_t i = 0; i < count; ++i) body(i);
+                return;
+            }
+
+            struct Batch
+            {
+                std::atomic<size_t>     remaining;
+                std::mutex              mutex;
+                std::condition_variable done;
+                std::exception_ptr      error;
+            };
+            auto batch = std::make_shared<Batch>();
+            batch->remaining.store(chunks, std::memory_order_relaxed);
+
+            for (size_t c = 0; c < chunks; ++c)
+            {
+                size_t begin = c * grain;
+                size_t end = std::min(count, begin + grain);
+                submit([batch, begin, end, &body] {
+                    try
+                    {
+                        for (size_t i = begin; i < end; ++i) body(i);
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(batch->mutex);
+                        if (!batch->error) batch->error = std::current_exception();
+                    }
+                    if (batch->remaining.fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        std::lock_guard<std::mutex> lock(batch->mutex);
+                        batch->done.notify_all();
+                    }
+                });
+            }
+
+            // Help out rather than block, then wait for chunks other threads are still running
+            size_t helper = nextQueue.load(std::memory_order_relaxed);
+            while (batch->remaining.load(std::memory_order_acquire) > 0)
+            {
+                if (runOne(helper++ % queues.size())) continue;
+                std::unique_lock<std::mutex> lock(batch->mutex);
+                batch->done.wait(lock, [&] { return batch->remaining.load(std::memory_order_acquire) == 0; });
+            }
+            if (batch->error) std::rethrow_exception(batch->error);
+        }
+
+    private:
+        struct TaskQueue
+        {
+            std::mutex                        mutex;
+            std::deque<std::function<void()>> tasks;
+        };
+
+        std::vector<std::unique_ptr<TaskQueue>> queues;
+        std::vector<std::thread>                workers;
+        std::atomic<size_t>                     nextQueue{0};
+
+        std::mutex              sleepMutex;
+        std::condition_variable wake;
+        size_t                  queued   = 0;     // tasks submitted but not yet taken; guarded by sleepMutex
+        bool                    stopping = false; // guarded by sleepMutex
+
+        /**
+         * Take one task - from the back of our own queue, else from the front of another's - and
+         * run it. Returns false if every queue was empty.
+         */
+        bool runOne(size_t self)
+        {
+            std::function<void()> task;
+            {
+                std::lock_guard<std::mutex> lock(queues[self]->mutex);
+                if (!queues[self]->tasks.empty())
+                {
+                    task = std::move(queues[self]->tasks.back());
+                    queues[self]->tasks.pop_back();
+                }
+            }
+            for (size_t offset = 1; !task && offset < queues.size(); ++offset)
+            {
+                TaskQueue& victim = *queues[(self + offset) % queues.size()];
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                if (!victim.tasks.empty())
+                {
+                    task = std::move(victim.tasks.front());
+                    victim.tasks.pop_front();
+                }
+            }
+            if (!task) return false;
+
+            {
+                std::lock_guard<std::mutex> lock(sleepMutex);
+                --queued;
+            }
+            task();
+            return true;
+        }
+
+        void workerLoop(size_t self)
+        {
+            while (true)
+            {
+                if (runOne(self)) continue;
+                std::unique_lock<std::mutex> lock(sleepMutex);
+                wake.wait(lock, [this] { return stopping || queued > 0; });
+                if (stopping && queued == 0) return;
+            }
+        }
+    };
+
+    /**
+     * @brief The process-wide pool used by library features that parallelize internally.
+     */
+    inline ThreadPool& defaultThreadPool()
+    {
+        static ThreadPool pool;
+        return pool;
+    }
+
+} // namespace stevensTerminal
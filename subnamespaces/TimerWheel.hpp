@@ -0,0 +1,449 @@
+#pragma once
+/**
+ * @file TimerWheel.hpp
+ * @brief Hierarchical timer wheel for spinners, tweens and other timed callbacks on the main loop.
+ *
+ * Timers live in four levels of 64 slots; level n slots are 64^n ticks wide. Adding or cancelling
+ * a timer is O(1), and service() walks only the slots that actually hold timers (a 64-bit mask
+ * per level says which), re-filing a coarse slot into finer ones as time reaches it. One wheel
+ * serviced once per frame replaces a ticker thread per animation.
+ *
+ * Periodic timers and tweens coalesce: however long it has been since the last service(), each
+ * fires at most once per pass, with the latest period index or progress. A stalled frame makes a
+ * spinner skip ahead rather than spin through every frame it missed.
+ *
+ * Not thread-safe: register, cancel and service from the thread that owns the curses screen.
+ *
+ * Usage:
+ *   stevensTerminal::TimerWheel& timers = stevensTerminal::animationTimers();
+ *   auto spinner = stevensTerminal::animateSpinner(timers, statusWin, 0, 2);   // Spinner.hpp
+ *   timers.tween(400, stevensTerminal::easing::outCubic, [&](float t) {
+ *       hpBars.draw(partyWin, 1, 12, static_cast<int>(t * hp), maxHp);
+ *   });
+ *   timers.after(2000, [&] { hideToast(); });
+ *   // every frame:
+ *   timers.service();
+ *   // when the spinner's job is done:
+ *   timers.cancel(spinner);
+ */
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <numbers>
+#include <vector>
+
+namespace stevensTerminal
+{
+    /**
+     * Easing curves for TimerWheel::tween(): each maps linear progress in [0, 1] to eased progress.
+     */
+    namespace easing
+    {
+        using Curve = float (*)(float);
+
+        inline float linear(float t)     { return t; }
+        inline float inQuad(float t)     { return t * t; }
+        inline float outQuad(float t)    { return t * (2.0f - t); }
+        inline float inOutQuad(float t)  { return t < 0.5f ? 2.0f * t * t : 1.0f - 2.0f * (1.0f - t) * (1.0f - t); }
+        inline float inCubic(float t)    { return t * t * t; }
+        inline float outCubic(float t)   { float u = 1.0f - t; return 1.0f - u * u * u; }
+        inline float inOutCubic(float t) { float u = 1.0f - t; return t < 0.5f ? 4.0f * t * t * t : 1.0f - 4.0f * u * u * u; }
+        inline float inOutSine(float t)  { return 0.5f - 0.5f * std::cos(t * std::numbers::pi_v<float>); }
+    }
+
+    class TimerWheel
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+        using Id = uint64_t;   // 0 is never a valid id
+
+        /**
+         * @brief What a tween does when it reaches the end of its duration.
+         *
+         * None     — reports 1 once and finishes
+         * Loop     — starts over from 0
+         * PingPong — runs back down to 0, then up again (pulses)
+         */
+        enum class Repeat { None, Loop, PingPong };
+
+        /**
+         * @param tickMs Resolution of the wheel. Delays are rounded up to whole ticks.
+         */
+        explicit TimerWheel(int tickMs = 1)
+            : msPerTick(static_cast<uint64_t>(std::max(tickMs, 1)))
+            , tickLength(std::chrono::milliseconds(std::max(tickMs, 1)))
+            , epoch(Clock::now())
+        {
+            heads.fill(Nil);
+        }
+
+        /**
+         * @brief Call callback() once, delayMs from now.
+         */
+        Id after(uint64_t delayMs, std::function<void()> callback)
+        {
+            const uint32_t index = allocate(Kind::Once, delayMs);
+            Timer& timer = timers[index];
+            timer.once = std::move(callback);
+            return schedule(index);
+        }
+
+        /**
+         * @brief Call callback(n) every periodMs, where n counts periods since the timer was added
+         * (1 on the first call). After a stall n skips ahead rather than replaying every period.
+         */
+        Id every(uint64_t periodMs, std::function<void(uint64_t period)> callback)
+        {
+            const uint32_t index = allocate(Kind::Every, periodMs);
+            Timer& timer = timers[index];
+            timer.periodic = std::move(callback);
+            return schedule(index);
+        }
+
+        /**
+         * @brief Call callback(curve(progress)) as progress runs from 0 to 1 over durationMs.
+         *
+         * With intervalMs = 0 the callback runs once per service() (once per frame); otherwise at
+         * most once per intervalMs. A Repeat::None tween always finishes with callback(curve(1)).
+         */
+        Id tween(uint64_t durationMs, easing::Curve curve, std::function<void(float progress)> callback,
+                 Repeat repeat = Repeat::None, uint64_t intervalMs = 0)
+        {
+            const uint32_t index = allocate(Kind::Tween, intervalMs);
+            Timer& timer = timers[index];
+            timer.progress = std::move(callback);
+            timer.curve = curve ? curve : easing::linear;
+            timer.duration = std::max<uint64_t>(toTicks(durationMs), 1);
+            timer.repeat = repeat;
+            if (repeat == Repeat::None) timer.deadline = std::min(timer.deadline, timer.start + timer.duration);
+            return schedule(index);
+        }
+
+        /**
+         * @brief Stop a timer. Safe to call from inside any callback, including the timer's own.
+         * @return False if the id is stale (the timer already finished or was cancelled)
+         */
+        bool cancel(Id id)
+        {
+            const uint32_t index = find(id);
+            if (index == Nil) return false;
+            if (index == firing)
+            {
+                ++timers[index].generation;
+                timers[index].cancelled = true;   // released once its callback returns
+            }
+            else
+            {
+                unlink(index);
+                release(index);
+            }
+            return true;
+        }
+
+        /** @brief True while the timer is scheduled (or running its callback). */
+        bool active(Id id) const { return find(id) != Nil; }
+
+        /** @brief Number of scheduled timers. */
+        size_t size() const { return liveCount; }
+        bool empty() const { return liveCount == 0; }
+
+        /**
+         * @brief Fire everything due by the steady clock.
+         * @return Number of callbacks run
+         */
+        size_t service()
+        {
+            return advanceTo(clockTicks());
+        }
+
+        /**
+         * @brief Move the wheel's time forward by ms, firing what falls due. For driving the
+         * wheel from a clock of your own (or a test) instead of service(); once advance() is used,
+         * new timers are timed from the wheel's own time rather than the steady clock.
+         * @return Number of callbacks run
+         */
+        size_t advance(uint64_t ms)
+        {
+            manualTime = true;
+            return advanceTo(current + ms / msPerTick);
+        }
+
+        /** @brief Ticks since the wheel was created (or advanced to). */
+        uint64_t now() const { return current; }
+
+    private:
+        static constexpr int      Bits   = 6;
+        static constexpr int      Slots  = 1 << Bits;
+        static constexpr uint64_t Mask   = Slots - 1;
+        static constexpr int      Levels = 4;
+        static constexpr uint64_t Span   = uint64_t{1} << (Bits * Levels);   // ticks the wheel covers
+        static constexpr uint32_t Nil    = 0xFFFFFFFFu;
+        static constexpr uint16_t NoSlot = 0xFFFF;
+
+        enum class Kind : uint8_t { Once, Every, Tween };
+
+        struct Timer
+        {
+            std::function<void()>         once;
+            std::function<void(uint64_t)> periodic;
+            std::function<void(float)>    progress;
+            easing::Curve                 curve = nullptr;
+            uint64_t                      deadline = 0;   // tick the timer fires at
+            uint64_t                      start    = 0;   // tick it was added at
+            uint64_t                      period   = 1;   // ticks between firings (Every / Tween)
+            uint64_t                      duration = 0;   // Tween only
+            uint32_t                      prev = Nil, next = Nil;
+            uint32_t                      generation = 1;
+            uint16_t                      slot = NoSlot;
+            Kind                          kind = Kind::Once;
+            Repeat                        repeat = Repeat::None;
+            bool                          live = false;
+            bool                          cancelled = false;
+        };
+
+        uint64_t                              msPerTick;
+        Clock::duration                       tickLength;
+        Clock::time_point                     epoch;
+        uint64_t                              current = 0;         // every slot up to this tick has fired
+        std::deque<Timer>                     timers;              // deque: references survive growth mid-callback
+        std::vector<uint32_t>                 freeList;
+        std::array<uint32_t, Levels * Slots>  heads;               // per-slot intrusive lists
+        std::array<uint64_t, Levels>          occupied{};          // bit s set when slot s holds timers
+        size_t                                liveCount = 0;
+        uint32_t                              firing = Nil;        // timer whose callback is running
+        bool                                  manualTime = false;  // driven by advance(), not the clock
+
+        uint64_t clockTicks() const
+        {
+            return static_cast<uint64_t>((Clock::now() - epoch) / tickLength);
+        }
+
+        uint64_t toTicks(uint64_t ms) const
+        {
+            return (ms + msPerTick - 1) / msPerTick;
+        }
+
+        uint32_t allocate(Kind kind, uint64_t periodMs)
+        {
+            uint32_t index;
+            if (!freeList.empty())
+            {
+                index = freeList.back();
+                freeList.pop_back();
+            }
+            else
+            {
+                index = static_cast<uint32_t>(timers.size());
+                timers.emplace_back();
+            }
+            Timer& timer = timers[index];
+            timer.kind = kind;
+            timer.live = true;
+            timer.cancelled = false;
+            // Anchor to the clock, not to the last service(): a wheel that sat idle would otherwise
+            // hand out timers that are already late
+            timer.start = manualTime ? current : std::max(current, clockTicks());
+            timer.period = std::max<uint64_t>(toTicks(periodMs), 1);
+            timer.deadline = timer.start + timer.period;
+            ++liveCount;
+            return index;
+        }
+
+        Id schedule(uint32_t index)
+        {
+            insert(index);
+            return (static_cast<uint64_t>(timers[index].generation) << 32) | (index + 1);
+        }
+
+        /** Index of the live timer an id refers to, or Nil if the id is stale. */
+        uint32_t find(Id id) const
+        {
+            const uint64_t slot = id & 0xFFFFFFFFu;
+            if (slot == 0 || slot > timers.size()) return Nil;
+            const Timer& timer = timers[slot - 1];
+            if (!timer.live || timer.cancelled || timer.generation != static_cast<uint32_t>(id >> 32)) return Nil;
+            return static_cast<uint32_t>(slot - 1);
+        }
+
+        void release(uint32_t index)
+        {
+            Timer& timer = timers[index];
+            timer.once = nullptr;
+            timer.periodic = nullptr;
+            timer.progress = nullptr;
+            timer.live = false;
+            ++timer.generation;
+            freeList.push_back(index);
+            --liveCount;
+        }
+
+        /** File a timer in the slot for its deadline: the finest level whose span reaches it. */
+        void insert(uint32_t index)
+        {
+            Timer& timer = timers[index];
+            const uint64_t delta = timer.deadline - current;
+            // Beyond the top level: park in its furthest slot and re-file when that slot comes round
+            const uint64_t when = delta >= Span ? current + Span - 1 : timer.deadline;
+            int level = 0;
+            while (level < Levels - 1 && (when - current) >> (Bits * (level + 1))) ++level;
+            const uint64_t slotInLevel = (when >> (Bits * level)) & Mask;
+            const uint16_t slot = static_cast<uint16_t>(level * Slots + slotInLevel);
+
+            timer.slot = slot;
+            timer.prev = Nil;
+            timer.next = heads[slot];
+            if (timer.next != Nil) timers[timer.next].prev = index;
+            heads[slot] = index;
+            occupied[level] |= uint64_t{1} << slotInLevel;
+        }
+
+        void unlink(uint32_t index)
+        {
+            Timer& timer = timers[index];
+            if (timer.slot == NoSlot) return;
+            if (timer.prev != Nil) timers[timer.prev].next = timer.next;
+            else heads[timer.slot] = timer.next;
+            if (timer.next != Nil) timers[timer.next].prev = timer.prev;
+            if (heads[timer.slot] == Nil) occupied[timer.slot / Slots] &= ~(uint64_t{1} << (timer.slot % Slots));
+            timer.slot = NoSlot;
+            timer.prev = timer.next = Nil;
+        }
+
+        /** Re-file every timer in a coarse slot now that time has reached it. */
+        void cascade(int level)
+        {
+            const uint16_t slot = static_cast<uint16_t>(level * Slots + ((current >> (Bits * level)) & Mask));
+            uint32_t index = heads[slot];
+            heads[slot] = Nil;
+            occupied[level] &= ~(uint64_t{1} << (slot % Slots));
+            while (index != Nil)
+            {
+                const uint32_t next = timers[index].next;
+                timers[index].slot = NoSlot;
+                insert(index);
+                index = next;
+            }
+        }
+
+        size_t advanceTo(uint64_t target)
+        {
+            size_t fired = 0;
+            while (current < target)
+            {
+                if (liveCount == 0)
+                {
+                    current = target;
+                    break;
+                }
+
+                // Next occupied level-0 slot before the level wraps, if any
+                const uint64_t slot0 = current & Mask;
+                const uint64_t ahead = slot0 == Mask ? 0 : occupied[0] & (~uint64_t{0} << (slot0 + 1));
+                if (ahead)
+                {
+                    const uint64_t due = (current & ~Mask) + static_cast<uint64_t>(std::countr_zero(ahead));
+                    if (due > target)
+                    {
+                        current = target;
+                        break;
+                    }
+                    current = due;
+                }
+                else
+                {
+                    const uint64_t boundary = (current | Mask) + 1;
+                    if (boundary > target)
+                    {
+                        current = target;
+                        break;
+                    }
+                    current = boundary;
+                    for (int level = 1; level < Levels; ++level)
+                    {
+                        cascade(level);
+                        if ((current >> (Bits * level)) & Mask) break;
+                    }
+                }
+                fired += fireSlot(static_cast<uint16_t>(current & Mask), target);
+            }
+            return fired;
+        }
+
+        size_t fireSlot(uint16_t slot, uint64_t target)
+        {
+            size_t fired = 0;
+            while (heads[slot] != Nil)
+            {
+                const uint32_t index = heads[slot];
+                unlink(index);
+                Timer& timer = timers[index];
+                firing = index;
+                bool finished = true;
+
+                if (timer.kind == Kind::Once)
+                {
+                    timer.once();
+                }
+                else if (timer.kind == Kind::Every)
+                {
+                    // Coalesce: skip to the last period boundary reached by target
+                    const uint64_t due = current + (target - current) / timer.period * timer.period;
+                    timer.periodic((due - timer.start) / timer.period);
+                    timer.deadline = due + timer.period;
+                    finished = false;
+                }
+                else
+                {
+                    const uint64_t end = timer.start + timer.duration;
+                    const uint64_t due = timer.repeat == Repeat::None ? std::min(target, end) : target;
+                    const uint64_t elapsed = due - timer.start;
+                    float t;
+                    if (timer.repeat == Repeat::None)
+                    {
+                        t = static_cast<float>(elapsed) / static_cast<float>(timer.duration);
+                        finished = due >= end;
+                    }
+                    else if (timer.repeat == Repeat::Loop)
+                    {
+                        t = static_cast<float>(elapsed % timer.duration) / static_cast<float>(timer.duration);
+                        finished = false;
+                    }
+                    else
+                    {
+                        const uint64_t phase = elapsed % (2 * timer.duration);
+                        t = static_cast<float>(phase <= timer.duration ? phase : 2 * timer.duration - phase)
+                          / static_cast<float>(timer.duration);
+                        finished = false;
+                    }
+                    timer.progress(timer.curve(std::min(t, 1.0f)));
+                    timer.deadline = due + timer.period;
+                    if (timer.repeat == Repeat::None) timer.deadline = std::min(timer.deadline, end);
+                }
+
+                firing = Nil;
+                ++fired;
+                if (finished || timer.cancelled) release(index);
+                else insert(index);
+            }
+            return fired;
+        }
+    };
+
+    /**
+     * @brief The wheel runAnimation() services each render tick. Register spinners and tweens here
+     * to have them animate alongside it, or service() it from your own frame loop.
+     */
+    inline TimerWheel& animationTimers()
+    {
+        static TimerWheel wheel;
+        return wheel;
+    }
+
+} // namespace stevensTerminal
@@ -6,8 +6,10 @@
 
 #include "../stevensTerminal.hpp"
 #include <clocale>
+#include <csignal>
 #include <iostream>
 #include <fstream>
+#include <set>
 #include <gtest/gtest.h>
 
 
@@ -1425,6 +1427,1438 @@ TEST_F(HeadlessNcursesTest, CursesWwrapWithTokens_LongTokenWrapsAcrossRows)
     EXPECT_NE(row0.back(), ' ');
 }
 
+/***** ScrollList - virtualized list over a data source callback *****/
+TEST_F(HeadlessNcursesTest, ScrollList_OnlyFormatsVisibleSliceAndPrefetch)
+{
+    WINDOW * listWin = newwin(10, 40, 0, 0);
+    size_t sourceCalls = 0;
+    stevensTerminal::ScrollListSpec spec;
+    spec.prefetch = 4;
+    stevensTerminal::ScrollList list(listWin, 100000, [&](size_t i) {
+        sourceCalls++;
+        return "item " + std::to_string(i);
+    }, spec);
+
+    list.render();
+
+    EXPECT_LE(sourceCalls, 10u + 4u); // 10 visible rows + the prefetch margin below them
+    EXPECT_LE(list.cachedItemCount(), 10u + 2 * 4u);
+    std::vector<char> buf(64, '\0');
+    mvwinnstr(listWin, 9, 0, buf.data(), 63);
+    EXPECT_EQ(std::string(buf.data()).substr(0, 6), "item 9");
+    delwin(listWin);
+}
+
+TEST_F(HeadlessNcursesTest, ScrollList_JumpToPlacesItemAtTop)
+{
+    WINDOW * listWin = newwin(10, 40, 0, 0);
+    size_t sourceCalls = 0;
+    stevensTerminal::ScrollList list(listWin, 100000, [&](size_t i) {
+        sourceCalls++;
+        return "item " + std::to_string(i);
+    });
+    list.render();
+    sourceCalls = 0;
+
+    list.jumpTo(50000);
+    list.render();
+
+    EXPECT_EQ(list.top(), 50000u);
+    EXPECT_EQ(list.selected(), 50000u);
+    EXPECT_LE(sourceCalls, 10u + 2 * 8u); // visible slice + default prefetch on both sides
+    std::vector<char> buf(64, '\0');
+    mvwinnstr(listWin, 0, 0, buf.data(), 63);
+    EXPECT_EQ(std::string(buf.data()).substr(0, 10), "item 50000");
+    delwin(listWin);
+}
+
+TEST_F(HeadlessNcursesTest, ScrollList_SelectionChangeOnlyRedrawsAffectedRows)
+{
+    WINDOW * listWin = newwin(10, 40, 0, 0);
+    stevensTerminal::ScrollList list(listWin, 100, [](size_t i) {
+        return "item " + std::to_string(i);
+    });
+    list.render();
+
+    // Scribble over a row the selection change doesn't involve - it must survive the re-render
+    mvwaddstr(listWin, 5, 0, "untouched");
+    list.select(1);
+    list.render();
+
+    std::vector<char> buf(64, '\0');
+    mvwinnstr(listWin, 5, 0, buf.data(), 9);
+    EXPECT_EQ(std::string(buf.data()), "untouched");
+    EXPECT_TRUE(mvwinch(listWin, 1, 0) & A_REVERSE);
+    EXPECT_FALSE(mvwinch(listWin, 0, 0) & A_REVERSE);
+    delwin(listWin);
+}
+
+TEST_F(HeadlessNcursesTest, ScrollList_ScrollByShiftsRowsAndFillsExposedOnes)
+{
+    WINDOW * listWin = newwin(10, 40, 0, 0);
+    stevensTerminal::ScrollList list(listWin, 100, [](size_t i) {
+        return "item " + std::to_string(i);
+    });
+    list.render();
+    wsetscrreg(listWin, 2, 5);
+    scrollok(listWin, TRUE);
+    list.scrollBy(3);
+    list.render();
+
+    std::vector<char> buf(64, '\0');
+    mvwinnstr(listWin, 0, 0, buf.data(), 6);
+    EXPECT_EQ(std::string(buf.data()), "item 3");
+    mvwinnstr(listWin, 9, 0, buf.data(), 7);
+    EXPECT_EQ(std::string(buf.data()), "item 12");
+
+    // The window's own scroll region and setting are left as they were
+    int top = 0, bottom = 0;
+    wgetscrreg(listWin, &top, &bottom);
+    EXPECT_EQ(top, 2);
+    EXPECT_EQ(bottom, 5);
+    EXPECT_TRUE(is_scrollok(listWin));
+    delwin(listWin);
+}
+
+TEST_F(HeadlessNcursesTest, ScrollList_HeightCacheStaysBoundedAcrossJumps)
+{
+    WINDOW * listWin = newwin(10, 40, 0, 0);
+    stevensTerminal::ScrollList list(listWin, 1000000, [](size_t i) {
+        return "item " + std::to_string(i);
+    });
+    for (size_t target : {0u, 250000u, 250005u, 999990u, 10u})
+    {
+        list.jumpTo(target);
+        list.render();
+        EXPECT_LE(list.cachedHeightCount(), 10u + 2 * 8u + 2 * 10u); // view + prefetch + a region either side
+    }
+
+    // Without wrapping every item is one row: nothing to measure or cache
+    stevensTerminal::ScrollListSpec spec;
+    spec.wrap = false;
+    stevensTerminal::ScrollList flat(listWin, 1000000, [](size_t i) { return "item " + std::to_string(i); }, spec);
+    flat.jumpTo(500000);
+    flat.render();
+    flat.scrollBy(3);
+    flat.render();
+    EXPECT_EQ(flat.cachedHeightCount(), 0u);
+    std::vector<char> buf(64, '\0');
+    mvwinnstr(listWin, 0, 0, buf.data(), 11);
+    EXPECT_EQ(std::string(buf.data()), "item 500003");
+    delwin(listWin);
+}
+
+TEST_F(HeadlessNcursesTest, ScrollList_VariableHeightItemsWrap)
+{
+    WINDOW * listWin = newwin(10, 14, 0, 0);
+    std::vector<std::string> items = {"a long first item", "second"};
+    stevensTerminal::ScrollListSpec spec;
+    spec.highlightSelection = false;
+    stevensTerminal::ScrollList list(listWin, items.size(), [&](size_t i) { return items[i]; }, spec);
+    list.render();
+
+    std::vector<char> buf(64, '\0');
+    mvwinnstr(listWin, 1, 0, buf.data(), 14);
+    EXPECT_EQ(std::string(buf.data()).substr(0, 4), "item"); // wrapped continuation of item 0
+    mvwinnstr(listWin, 2, 0, buf.data(), 14);
+    EXPECT_EQ(std::string(buf.data()).substr(0, 6), "second");
+    delwin(listWin);
+}
+
+/***** FileViewer / curses_wprintFile *****/
+TEST_F(HeadlessNcursesTest, FileViewer_IndexesLinesAndJumpsToLine)
+{
+    std::string path = "fileviewer_test.txt";
+    {
+        std::ofstream out(path);
+        for (int i = 0; i < 1000; i++) out << "line " << i << "\r\n";
+    }
+
+    WINDOW * viewWin = newwin(12, 40, 0, 0);
+    {
+        stevensTerminal::FileViewer viewer(viewWin, path);
+        viewer.waitForIndex();
+        EXPECT_EQ(viewer.lineCount(), 1000u);
+        EXPECT_EQ(viewer.lineAt(999), "line 999"); // '\r' stripped
+
+        viewer.render();
+        std::vector<char> buf(64, '\0');
+        mvwinnstr(viewWin, 1, 1, buf.data(), 6);
+        EXPECT_EQ(std::string(buf.data()), "line 0"); // inside the border
+
+        viewer.jumpToLine(500);
+        viewer.render();
+        mvwinnstr(viewWin, 1, 1, buf.data(), 8);
+        EXPECT_EQ(std::string(buf.data()), "line 500");
+    }
+    delwin(viewWin);
+    std::remove(path.c_str());
+}
+
+TEST_F(HeadlessNcursesTest, CursesWprintFile_WithoutAvoidBordersPrintsAtOrigin)
+{
+    std::string path = "wprintfile_test.txt";
+    {
+        std::ofstream out(path);
+        out << "hello";
+    }
+    stevensTerminal::curses_wprintFile(win, path, {}, {{"avoid borders", "false"}});
+    EXPECT_EQ(readRow(0), "hello");
+    std::remove(path.c_str());
+}
+
+TEST(TextSearch, SubstringFinderMatchesStdFind)
+{
+    std::string haystack;
+    for (int i = 0; i < 2000; i++) haystack += static_cast<char>('a' + (i * 7919) % 5);
+    for (std::string needle : {"a", "ab", "cad", "bacde", "eabcdeabc", "zzzz"})
+    {
+        stevensTerminal::SubstringFinder finder(needle);
+        for (size_t from = 0; from < haystack.size(); from += 37)
+        {
+            EXPECT_EQ(finder.find(haystack, from), haystack.find(needle, from)) << needle << " from " << from;
+        }
+    }
+}
+
+TEST(TextSearch, BufferSearchReportsLineAndColumn)
+{
+    std::string text = "alpha\nbeta gamma\r\n\nthe gamma ray gamma\nlast";
+    for (std::string needle : {"gam", "gamma ray"})
+    {
+        stevensTerminal::TextSearch search;
+        search.start(text, needle);
+        while (!search.isDone()) std::this_thread::yield();
+        std::vector<stevensTerminal::SearchMatch> matches = search.takeNewMatches();
+        if (needle == "gam")
+        {
+            ASSERT_EQ(matches.size(), 3u);
+            EXPECT_EQ(matches[0].line, 1u);
+            EXPECT_EQ(matches[0].column, 5u);
+            EXPECT_EQ(matches[1].line, 3u);
+            EXPECT_EQ(matches[1].column, 4u);
+            EXPECT_EQ(matches[2].line, 3u);
+            EXPECT_EQ(matches[2].column, 14u);
+        }
+        else
+        {
+            ASSERT_EQ(matches.size(), 1u);
+            EXPECT_EQ(matches[0].line, 3u);
+            EXPECT_EQ(matches[0].column, 4u);
+            EXPECT_EQ(matches[0].length, 9u);
+        }
+        EXPECT_DOUBLE_EQ(search.progress(), 1.0);
+    }
+}
+
+TEST_F(HeadlessNcursesTest, FileViewer_SearchHighlightsMatchesByAttribute)
+{
+    std::string path = "filesearch_test.txt";
+    {
+        std::ofstream out(path);
+        for (int i = 0; i < 200; i++) out << (i % 50 == 7 ? "found the needle here" : "nothing to see") << "\n";
+    }
+
+    WINDOW * viewWin = newwin(12, 40, 0, 0);
+    {
+        stevensTerminal::FileViewer viewer(viewWin, path);
+        viewer.waitForIndex();
+        viewer.render();
+        viewer.search("needle");
+        while (!viewer.searchComplete()) std::this_thread::yield();
+        viewer.render();
+        EXPECT_EQ(viewer.matchCount(), 4u);
+
+        // Line 7 is on row 8 (inside the border); "needle" starts at column 10 of the line
+        EXPECT_TRUE(mvwinch(viewWin, 8, 1 + 10) & A_REVERSE);
+        EXPECT_TRUE(mvwinch(viewWin, 8, 1 + 15) & A_REVERSE);
+        EXPECT_FALSE(mvwinch(viewWin, 8, 1 + 9) & A_REVERSE);
+        EXPECT_FALSE(mvwinch(viewWin, 8, 1 + 16) & A_REVERSE);
+        EXPECT_FALSE(mvwinch(viewWin, 7, 1 + 10) & A_REVERSE);
+
+        EXPECT_TRUE(viewer.jumpToNextMatch());
+        EXPECT_EQ(viewer.topLine(), 7u);
+        EXPECT_TRUE(viewer.jumpToNextMatch());
+        EXPECT_EQ(viewer.topLine(), 57u);
+        viewer.render();
+        EXPECT_TRUE(mvwinch(viewWin, 1, 1 + 10) & A_REVERSE);
+
+        viewer.clearSearch();
+        viewer.render();
+        EXPECT_FALSE(mvwinch(viewWin, 1, 1 + 10) & A_REVERSE);
+    }
+    delwin(viewWin);
+    std::remove(path.c_str());
+}
+
+TEST_F(HeadlessNcursesTest, FileViewer_SearchHighlightsFollowTabsAndStyleMarkup)
+{
+    std::string path = "filesearch_layout_test.txt";
+    {
+        std::ofstream out(path);
+        out << "\tneedle\n";                          // shown from the tab stop at column 8
+        out << "{warn}$[bold=true] needle\n";          // shown as "warn needle"
+        out << "plain\n";
+    }
+
+    WINDOW * viewWin = newwin(12, 40, 0, 0);
+    {
+        stevensTerminal::FileViewer viewer(viewWin, path);
+        viewer.waitForIndex();
+        viewer.search("needle");
+        while (!viewer.searchComplete()) std::this_thread::yield();
+        viewer.render();
+        EXPECT_EQ(viewer.matchCount(), 2u);
+
+        // Rows 1 and 2 inside the border, columns offset by 1 for it
+        EXPECT_FALSE(mvwinch(viewWin, 1, 1 + 7) & A_REVERSE);
+        EXPECT_TRUE(mvwinch(viewWin, 1, 1 + 8) & A_REVERSE);
+        EXPECT_TRUE(mvwinch(viewWin, 1, 1 + 13) & A_REVERSE);
+        EXPECT_FALSE(mvwinch(viewWin, 1, 1 + 14) & A_REVERSE);
+
+        EXPECT_FALSE(mvwinch(viewWin, 2, 1 + 4) & A_REVERSE);
+        EXPECT_TRUE(mvwinch(viewWin, 2, 1 + 5) & A_REVERSE);
+        EXPECT_TRUE(mvwinch(viewWin, 2, 1 + 10) & A_REVERSE);
+        EXPECT_FALSE(mvwinch(viewWin, 2, 1 + 11) & A_REVERSE);
+    }
+    delwin(viewWin);
+    std::remove(path.c_str());
+}
+
+TEST_F(HeadlessNcursesTest, WindowManager_IdsResolveOnceAndCarryMetadata)
+{
+    stevensTerminal::WindowManager wm;
+    std::vector<stevensTerminal::WindowId> ids = wm.initialize({"header", "body"});
+    ASSERT_EQ(ids.size(), 2u);
+    EXPECT_EQ(wm.getWindowId("header"), ids[0]);
+    EXPECT_EQ(wm.getWindowId("body"), ids[1]);
+    EXPECT_FALSE(wm.findWindowId("missing").valid());
+    EXPECT_EQ(wm.getWindow(ids[1]), wm.getWindow("body"));
+    EXPECT_EQ(wm[ids[0]], wm["header"]);
+
+    stevensTerminal::WindowId footer = wm.getWindowId("footer");
+    EXPECT_EQ(wm.windowCount(), 3u);
+    EXPECT_EQ(wm.getWindowNames(), (std::vector<std::string>{"header", "body", "footer"}));
+    EXPECT_GT(wm.info(footer).zOrder, wm.info(ids[1]).zOrder);
+
+    wm.configureWindow(ids[1], stevensTerminal::WindowSpec(5, 20, 2, 3));
+    EXPECT_EQ(wm.info(ids[1]).spec, stevensTerminal::WindowSpec(5, 20, 2, 3));
+    EXPECT_EQ(getmaxy(wm[ids[1]]), 5);
+    EXPECT_EQ(getbegx(wm[ids[1]]), 3);
+    EXPECT_TRUE(wm.isDirty(ids[1]));
+
+    wm.refreshAll();
+    EXPECT_FALSE(wm.isDirty(ids[1]));
+    wm.markDirty(ids[1]);
+    EXPECT_TRUE(wm.isDirty(ids[1]));
+
+    wm.cleanup();
+    EXPECT_EQ(wm.getWindow(ids[0]), nullptr);
+}
+
+TEST_F(HeadlessNcursesTest, WindowManager_RefreshAllStagesOnlyDirtyWindowsInZOrder)
+{
+    stevensTerminal::WindowManager wm;
+    std::vector<stevensTerminal::WindowId> ids = wm.initialize({"top", "bottom", "side"});
+    stevensTerminal::WindowId top = ids[0], bottom = ids[1], side = ids[2];
+    wm.configureWindow(bottom, stevensTerminal::WindowSpec(4, 10, 0, 0));
+    wm.configureWindow(top, stevensTerminal::WindowSpec(2, 4, 1, 1));
+    wm.configureWindow(side, stevensTerminal::WindowSpec(4, 10, 0, 20));
+    wm.setZOrder(bottom, 0);
+    wm.setZOrder(top, 5);
+    wm.setZOrder(side, 1);
+
+    wbkgd(wm[bottom], 'b');
+    wbkgd(wm[top], 't');
+    wbkgd(wm[side], 's');
+    wm.refreshAll();
+    EXPECT_EQ(wm.stagedWindowCount(), 3u);
+    EXPECT_EQ(static_cast<char>(mvwinch(curscr, 1, 1) & A_CHARTEXT), 't'); // z-order, not creation order
+    EXPECT_EQ(static_cast<char>(mvwinch(curscr, 0, 0) & A_CHARTEXT), 'b');
+
+    // Nothing changed: nothing staged
+    wm.refreshAll();
+    EXPECT_EQ(wm.stagedWindowCount(), 0u);
+
+    // Printing into the lower window restages the window overlapping it from above, but not the
+    // unrelated one
+    mvwaddstr(wm[bottom], 1, 0, "xxxxxxxxxx");
+    EXPECT_TRUE(wm.isDirty(bottom));
+    wm.refreshAll();
+    EXPECT_EQ(wm.stagedWindowCount(), 2u);
+    EXPECT_EQ(static_cast<char>(mvwinch(curscr, 1, 1) & A_CHARTEXT), 't');
+    EXPECT_EQ(static_cast<char>(mvwinch(curscr, 1, 0) & A_CHARTEXT), 'x');
+
+    // A window entirely behind another is skipped and stays dirty until uncovered
+    wm.configureWindow(top, stevensTerminal::WindowSpec(4, 10, 0, 0));
+    wm.refreshAll();
+    mvwaddstr(wm[bottom], 0, 0, "hidden");
+    wm.refreshAll();
+    EXPECT_EQ(wm.stagedWindowCount(), 0u);
+    EXPECT_TRUE(wm.isDirty(bottom));
+
+    wm.configureWindow(top, stevensTerminal::WindowSpec(1, 1, 3, 9));
+    wm.refreshAll();
+    EXPECT_FALSE(wm.isDirty(bottom));
+    EXPECT_EQ(static_cast<char>(mvwinch(curscr, 0, 0) & A_CHARTEXT), 'h');
+}
+
+TEST_F(HeadlessNcursesTest, WindowManager_OcclusionFollowsWindowsMovedOutsideTheManager)
+{
+    stevensTerminal::WindowManager wm;
+    std::vector<stevensTerminal::WindowId> ids = wm.initialize({"under", "over"});
+    stevensTerminal::WindowId under = ids[0], over = ids[1];
+    wm.configureWindow(under, stevensTerminal::WindowSpec(3, 6, 0, 0));
+    wm.configureWindow(over, stevensTerminal::WindowSpec(3, 6, 0, 0));
+    wbkgd(wm[under], 'u');
+    wbkgd(wm[over], 'o');
+    wm.refreshAll();
+    mvwaddstr(wm[under], 2, 0, "seen");
+    wm.refreshAll();
+    EXPECT_EQ(wm.stagedWindowCount(), 0u);
+    EXPECT_TRUE(wm.isDirty(under));
+
+    // Shrinking the covering window straight through curses uncovers the bottom row
+    wresize(wm[over], 2, 6);
+    wm.refreshAll();
+    EXPECT_FALSE(wm.isDirty(under));
+    EXPECT_EQ(static_cast<char>(mvwinch(curscr, 2, 0) & A_CHARTEXT), 's');
+    EXPECT_EQ(static_cast<char>(mvwinch(curscr, 0, 0) & A_CHARTEXT), 'o');
+}
+
+TEST(Layout, SolvesFixedMinMaxAndFlexSizes)
+{
+    using stevensTerminal::LayoutNode;
+    using stevensTerminal::LayoutSize;
+    using stevensTerminal::WindowSpec;
+    stevensTerminal::Layout layout(LayoutNode::column({
+        LayoutNode::window("header", LayoutSize::exactly(3)),
+        LayoutNode::row({
+            LayoutNode::window("menu", LayoutSize::weighted(1, 0, 20)),
+            LayoutNode::window("art", LayoutSize::weighted(2)),
+            LayoutNode::window("log", LayoutSize::weighted(2)),
+        }),
+        LayoutNode::window("prompt", LayoutSize::exactly(2)),
+    }));
+
+    const std::vector<stevensTerminal::LayoutPlacement>& placements = layout.solve(121, 40);
+    ASSERT_EQ(placements.size(), 5u);
+    EXPECT_EQ(placements[0].spec, WindowSpec(3, 121, 0, 0));
+    EXPECT_EQ(placements[1].spec, WindowSpec(35, 20, 3, 0));   // 121/5 = 24.2 capped at 20
+    EXPECT_EQ(placements[2].spec, WindowSpec(35, 51, 3, 20));  // remaining 101 split 50.5 / 50.5
+    EXPECT_EQ(placements[3].spec, WindowSpec(35, 50, 3, 71));
+    EXPECT_EQ(placements[4].spec, WindowSpec(2, 121, 38, 0));
+    EXPECT_EQ(&layout.solve(121, 40), &placements);            // cached per size
+}
+
+TEST_F(HeadlessNcursesTest, Layout_ApplyOnlyTouchesChangedWindowsAndHonoursBreakpoints)
+{
+    using stevensTerminal::LayoutNode;
+    using stevensTerminal::LayoutSize;
+    stevensTerminal::WindowManager wm;
+    stevensTerminal::Layout layout(LayoutNode::row({
+        LayoutNode::window("left", LayoutSize::exactly(30)),
+        LayoutNode::window("right"),
+    }));
+    layout.addBreakpoint("very small", LayoutNode::column({
+        LayoutNode::window("left", LayoutSize::exactly(5)),
+        LayoutNode::window("right"),
+    }));
+
+    EXPECT_EQ(layout.apply(wm, 130, 50), 2u);
+    EXPECT_EQ(layout.apply(wm, 130, 50), 0u);
+    stevensTerminal::WindowId left = wm.getWindowId("left");
+    stevensTerminal::WindowId right = wm.getWindowId("right");
+    EXPECT_EQ(getmaxx(wm[right]), 100);
+
+    // Only the flexible window's geometry depends on the width
+    mvwaddstr(wm[left], 0, 0, "keep");
+    EXPECT_EQ(layout.apply(wm, 140, 50), 1u);
+    EXPECT_EQ(getmaxx(wm[right]), 110);
+    std::vector<char> buf(8, '\0');
+    mvwinnstr(wm[left], 0, 0, buf.data(), 4);
+    EXPECT_EQ(std::string(buf.data()), "keep");
+
+    EXPECT_EQ(layout.displayModeAt(60, 20), "very small");
+    EXPECT_EQ(layout.apply(wm, 60, 20), 2u);
+    EXPECT_EQ(wm.info(left).spec, stevensTerminal::WindowSpec(5, 60, 0, 0));
+    EXPECT_EQ(wm.info(right).spec, stevensTerminal::WindowSpec(15, 60, 5, 0));
+}
+
+TEST_F(HeadlessNcursesTest, Resize_SignalStormsAreDebouncedAndSizeIsCached)
+{
+    int callbacks = 0;
+    stevensTerminal::startResizeWatch([&](const stevensTerminal::ResizeEvent&) { callbacks++; },
+                                      std::chrono::milliseconds(30));
+    ASSERT_GE(stevensTerminal::resizeEventFd(), 0);
+    std::pair<int,int> before = stevensTerminal::get_screen_size();
+
+    for (int i = 0; i < 5; i++) std::raise(SIGWINCH);
+    EXPECT_FALSE(stevensTerminal::pollResize());
+    EXPECT_TRUE(stevensTerminal::resizePending());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(40));
+    // Settled, but the terminal didn't actually change size: no callback
+    EXPECT_FALSE(stevensTerminal::pollResize());
+    EXPECT_FALSE(stevensTerminal::resizePending());
+    EXPECT_EQ(callbacks, 0);
+    EXPECT_EQ(stevensTerminal::get_screen_size(), before);
+
+    stevensTerminal::stopResizeWatch();
+    EXPECT_EQ(stevensTerminal::resizeEventFd(), -1);
+}
+
+TEST(FrameScheduler, PacesFramesAgainstAbsoluteDeadlines)
+{
+    stevensTerminal::FrameScheduler frames(100.0);
+    auto start = std::chrono::steady_clock::now();
+    float totalDelta = 0.0f;
+    for (int i = 0; i < 10; i++)
+    {
+        totalDelta += frames.beginFrame();
+        std::this_thread::sleep_for(std::chrono::milliseconds(4)); // work shorter than the period
+        frames.endFrame();
+    }
+    double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+    // 9 waits of 10ms; frame work must not be added on top of the period
+    EXPECT_GE(elapsedMs, 85.0);
+    EXPECT_LT(elapsedMs, 140.0);
+    EXPECT_NEAR(totalDelta, 0.1f, 0.03f);
+
+    stevensTerminal::FrameStats stats = frames.stats();
+    EXPECT_EQ(stats.frames, 10u);
+    EXPECT_EQ(stats.missedFrames, 0u);
+    EXPECT_DOUBLE_EQ(stats.targetMs, 10.0);
+    EXPECT_GE(stats.p50Ms, 3.5);
+    EXPECT_GE(stats.p99Ms, stats.p50Ms);
+    EXPECT_GE(stats.maxMs, stats.p99Ms);
+}
+
+TEST(FrameScheduler, CountsMissedFramesAndClampsDelta)
+{
+    stevensTerminal::FrameScheduler frames(100.0, 240, 0.02f);
+    frames.beginFrame();
+    std::this_thread::sleep_for(std::chrono::milliseconds(45)); // overrun by several periods
+    frames.endFrame();
+    float delta = frames.beginFrame();
+    frames.endFrame();
+
+    EXPECT_FLOAT_EQ(delta, 0.02f);
+    EXPECT_GE(frames.stats().missedFrames, 2u);
+    EXPECT_GE(frames.stats().maxMs, 40.0);
+
+    frames.resetStats();
+    EXPECT_EQ(frames.stats().frames, 0u);
+    EXPECT_EQ(frames.stats().missedFrames, 0u);
+}
+
+TEST_F(HeadlessNcursesTest, RenderQueue_DrainsCommandsFromManyThreadsAndCoalesces)
+{
+    stevensTerminal::RenderQueue renderQueue;
+    WINDOW * logWin = newwin(3, 20, 10, 0);
+
+    std::vector<std::thread> producers;
+    for (int t = 0; t < 4; t++)
+    {
+        producers.emplace_back([&renderQueue, logWin, t] {
+            for (int i = 0; i < 100; i++)
+            {
+                renderQueue.print(stdscr, 0, 0, "ignored");
+                renderQueue.appendLog(logWin, "t" + std::to_string(t) + " line " + std::to_string(i));
+            }
+        });
+    }
+    for (std::thread& producer : producers) producer.join();
+    renderQueue.print(win, 0, 0, "progress 1");
+    renderQueue.print(win, 0, 0, "progress 2");
+    renderQueue.print(win, 1, 0, "other row");
+
+    size_t applied = renderQueue.drain();
+    // 400 stdscr prints and the first win print collapse to one each; 400 log lines stay
+    EXPECT_EQ(applied, 1u + 2u + 400u);
+    EXPECT_EQ(renderQueue.coalescedCount(), 399u + 1u);
+    EXPECT_EQ(readRow(0), "progress 2");
+    EXPECT_EQ(readRow(1), "other row");
+
+    const std::deque<std::string>* lines = renderQueue.logLines(logWin);
+    ASSERT_NE(lines, nullptr);
+    EXPECT_EQ(lines->size(), 3u); // capped to the pane height
+    std::vector<char> buf(32, '\0');
+    mvwinnstr(logWin, 2, 0, buf.data(), 20);
+    std::string lastRow(buf.data());
+    EXPECT_EQ(lastRow.substr(0, lastRow.find_last_not_of(' ') + 1), lines->back());
+
+    EXPECT_EQ(renderQueue.drain(), 0u);
+    int calls = 0;
+    renderQueue.post([&] { calls++; });
+    renderQueue.post([&] { calls++; });
+    EXPECT_EQ(renderQueue.drain(), 2u);
+    EXPECT_EQ(calls, 2);
+    delwin(logWin);
+}
+
+TEST(ThreadPool, ParallelForRunsEveryIndexOnceAndRethrows)
+{
+    stevensTerminal::ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(1000);
+    pool.parallelFor(hits.size(), [&](size_t i) { hits[i]++; }, 7);
+    for (const std::atomic<int>& hit : hits) EXPECT_EQ(hit.load(), 1);
+
+    // Nested parallelFor from inside a task must not deadlock
+    std::atomic<int> inner{0};
+    pool.parallelFor(8, [&](size_t) {
+        pool.parallelFor(8, [&](size_t) { inner++; });
+    });
+    EXPECT_EQ(inner.load(), 64);
+
+    EXPECT_THROW(pool.parallelFor(50, [](size_t i) {
+        if (i == 17) throw std::runtime_error("boom");
+    }), std::runtime_error);
+}
+
+TEST_F(HeadlessNcursesTest, FramePipeline_MatchesCursesWprintAndSkipsCleanPanes)
+{
+    struct Case
+    {
+        int y, x;
+        std::string text;
+        std::unordered_map<std::string,std::string> format;
+    };
+    std::vector<Case> cases = {
+        {0, 0, "plain text", {}},
+        {1, 5, "{bold}$[bold=true] and {under}$[underline=true] tokens", {}},
+        {2, 10, "a fairly long line that runs off the right-hand edge of this narrow pane and keeps going", {}},
+        {1, 1, "wrapped {text}$[reverse=true] that needs a few rows to fit inside the borders", {{"wrap", "true"}, {"avoid borders", "true"}}},
+        {0, 0, "first\nsecond line\tafter tab", {}},
+        {3, 2, "centred words wrap across rows", {{"wrap", "true"}, {"textAlign", "center"}}},
+    };
+
+    WINDOW* direct = newwin(8, 30, 0, 0);
+    WINDOW* piped = newwin(8, 30, 10, 0);
+    stevensTerminal::ThreadPool pool(2);
+    stevensTerminal::FramePipeline pipeline(pool);
+
+    for (const Case& c : cases)
+    {
+        werase(direct);
+        stevensTerminal::PrintHelper::curses_wprint(direct, c.y, c.x, c.text, {}, c.format, true);
+        pipeline.beginPane(piped);
+        pipeline.print(piped, c.y, c.x, c.text, {}, c.format);
+        pipeline.renderFrame(false);
+
+        for (int y = 0; y < 8; y++)
+        {
+            for (int x = 0; x < 30; x++)
+            {
+                ASSERT_EQ(mvwinch(piped, y, x), mvwinch(direct, y, x))
+                    << "'" << c.text << "' differs at row " << y << ", column " << x;
+            }
+        }
+    }
+
+    // Only panes that changed since the last frame are rasterized again
+    WINDOW* other = newwin(4, 30, 20, 0);
+    pipeline.beginPane(other);
+    pipeline.print(other, 0, 0, "status");
+    pipeline.renderFrame(false);
+    EXPECT_EQ(pipeline.rasterizedCount(), 1u);
+    pipeline.renderFrame(false);
+    EXPECT_EQ(pipeline.rasterizedCount(), 0u);
+    EXPECT_EQ(pipeline.buffer(other)->rowText(0).substr(0, 6), "status");
+
+    pipeline.removePane(other);
+    delwin(other);
+    delwin(piped);
+    delwin(direct);
+}
+
+TEST_F(HeadlessNcursesTest, ParticleEffect_SoAUpdateMatchesPerParticleStepping)
+{
+    using namespace stevensTerminal::ParticleFX;
+    Particle prototype;
+    prototype.setPhysics(ParticlePresets::Stone());
+    prototype.setLifetime(10.0f);
+    prototype.setModifyChar(true);
+    prototype.setCharacter('*');
+    prototype.setPosition(70.0f, 2.0f);
+    prototype.setVelocity(40.0f, -5.0f);
+
+    ParticleEffect effect(win);
+    effect.addParticle(prototype);
+    Particle other = prototype;
+    other.setPosition(5.0f, 20.0f);
+    effect.addParticle(other);
+    EXPECT_EQ(effect.getGroupCount(), 1u); // same physics and look: one shared group
+
+    // The reference: the per-particle path, which bounces off the right wall and the floor
+    std::mt19937 unused;
+    Particle reference = prototype;
+    for (int step = 0; step < 90; step++)
+    {
+        effect.update(1.0f / 30.0f);
+        reference.update(1.0f / 30.0f, unused);
+        reference.handleBoundaries(0, 80, 0, 24);
+    }
+
+    werase(win);
+    effect.render();
+    auto [x, y] = reference.getRenderPosition();
+    EXPECT_EQ(static_cast<char>(mvwinch(win, y, x) & A_CHARTEXT), '*');
+    EXPECT_EQ(effect.getParticleCount(), 2u);
+
+    effect.update(10.0f);
+    EXPECT_EQ(effect.getParticleCount(), 0u);
+    EXPECT_EQ(effect.getGroupCount(), 0u);
+}
+
+TEST_F(HeadlessNcursesTest, ParticleEffect_PoolReusesSlotsAndDrawsByLayer)
+{
+    using namespace stevensTerminal::ParticleFX;
+    Particle spark;
+    spark.setLifetime(0.5f);
+    spark.setPhysics(ParticlePresets::Firework());
+
+    ParticleEffect effect(win);
+    size_t capacityAfterFirstWave = 0;
+    for (int wave = 0; wave < 5; wave++)
+    {
+        effect.spawnBurst(Vec2(40, 12), 200, spark);
+        EXPECT_EQ(effect.getParticleCount(), 200u);
+        for (int step = 0; step < 20; step++) effect.update(1.0f / 30.0f);
+        EXPECT_EQ(effect.getParticleCount(), 0u);
+        if (wave == 0) capacityAfterFirstWave = effect.getCapacity();
+    }
+    EXPECT_EQ(effect.getCapacity(), capacityAfterFirstWave); // later waves reuse the dead slots
+
+    effect.setMaxParticles(50);
+    effect.spawnBurst(Vec2(40, 12), 200, spark);
+    EXPECT_EQ(effect.getParticleCount(), 50u);
+    effect.clear();
+    effect.setMaxParticles(0);
+
+    // Higher layers draw over lower ones regardless of spawn order
+    Particle front, back;
+    for (Particle* p : {&front, &back})
+    {
+        p->setModifyChar(true);
+        p->setLifetime(5.0f);
+        p->setPosition(3.0f, 3.0f);
+    }
+    front.setCharacter('F');
+    front.setLayer(2);
+    back.setCharacter('B');
+    effect.addParticle(front);
+    effect.addParticle(back);
+    effect.render();
+    EXPECT_EQ(static_cast<char>(mvwinch(win, 3, 3) & A_CHARTEXT), 'F');
+    EXPECT_EQ(effect.getGroupCount(), 2u);
+}
+
+TEST_F(HeadlessNcursesTest, ParticleEffect_SameSeedReplaysIdentically)
+{
+    using namespace stevensTerminal::ParticleFX;
+    ParticleRng rng(7);
+    for (int i = 0; i < 1000; i++)
+    {
+        float value = rng.uniform(-2.0f, 3.0f);
+        ASSERT_GE(value, -2.0f);
+        ASSERT_LT(value, 3.0f);
+        int roll = rng.uniformInt(1, 6);
+        ASSERT_GE(roll, 1);
+        ASSERT_LE(roll, 6);
+    }
+    EXPECT_NE(ParticleRng::stream(7, 0)(), ParticleRng::stream(7, 1)());
+
+    Particle confetti;
+    confetti.setPhysics(ParticlePresets::Confetti());
+    confetti.setModifyChar(true);
+    confetti.setCharacter('*');
+    confetti.setLifetime(5.0f);
+
+    auto runEffect = [&](uint64_t seed) {
+        werase(win);
+        ParticleEffect effect(win, seed);
+        effect.spawnBurst(Vec2(40, 12), 30, confetti);
+        for (int step = 0; step < 45; step++) effect.update(1.0f / 30.0f);
+        effect.render();
+        std::string frame;
+        for (int y = 0; y < 24; y++) frame += readRow(y) + "\n";
+        return frame;
+    };
+
+    std::string first = runEffect(1234);
+    EXPECT_EQ(runEffect(1234), first);
+    EXPECT_NE(runEffect(4321), first);
+}
+
+TEST_F(HeadlessNcursesTest, ParticleWindowRegistry_RestoresOnlyTouchedCells)
+{
+    using namespace stevensTerminal::ParticleFX;
+    for (int y = 0; y < 24; y++) mvwprintw(win, y, 0, "row %02d: the quick brown fox jumps over the lazy dog", y);
+    std::vector<std::string> before;
+    for (int y = 0; y < 24; y++) before.push_back(readRow(y));
+
+    ParticleWindowRegistry::registerWindow(win);
+    Particle spark;
+    spark.setModifyChar(true);
+    spark.setCharacter('#');
+    spark.setLifetime(5.0f);
+    ParticleEffect effect(win, 99);
+    effect.spawnBurst(Vec2(20, 10), 40, spark);
+    effect.update(0.2f);
+    effect.render();
+
+    size_t touched = ParticleWindowRegistry::touchedCount(win);
+    EXPECT_GT(touched, 0u);
+    EXPECT_LE(touched, 40u);
+    chtype underneath = 0;
+    ASSERT_TRUE(ParticleWindowRegistry::snapshotCell(win, 3, 0, underneath));
+    EXPECT_EQ(static_cast<char>(underneath & A_CHARTEXT), 'r');
+
+    EXPECT_EQ(ParticleWindowRegistry::restoreTouched(win), touched);
+    EXPECT_EQ(ParticleWindowRegistry::touchedCount(win), 0u);
+    for (int y = 0; y < 24; y++) EXPECT_EQ(readRow(y), before[y]) << "row " << y;
+
+    ParticleWindowRegistry::unregisterWindow(win);
+    EXPECT_FALSE(ParticleWindowRegistry::hasActiveEffects(win));
+}
+
+TEST_F(HeadlessNcursesTest, EffectManager_RunsEffectsConcurrentlyAndRetiresThem)
+{
+    using namespace stevensTerminal::ParticleFX;
+    WINDOW* other = newwin(5, 20, 0, 50);
+    mvwprintw(win, 5, 5, "status text");
+
+    Particle spark;
+    spark.setModifyChar(true);
+    spark.setCharacter('*');
+    spark.setLifetime(0.3f);
+    spark.setPhysics(ParticlePresets::Firework());
+
+    EffectManager effects;
+    ParticleEffect timed(win, 1);
+    timed.spawnBurst(Vec2(10, 5), 20, spark);
+    EffectManager::EffectId timedId = effects.add(std::move(timed), 0.2f);
+    ParticleEffect untilDead(other, 2);
+    untilDead.spawnBurst(Vec2(10, 2), 20, spark);
+    effects.add(std::move(untilDead));
+    EXPECT_TRUE(ParticleWindowRegistry::hasActiveEffects(win));
+    ASSERT_NE(effects.get(timedId), nullptr);
+
+    EXPECT_EQ(effects.tick(0.1f), 2u);
+    EXPECT_GT(ParticleWindowRegistry::touchedCount(win), 0u);
+    EXPECT_EQ(effects.tick(0.1f), 1u);  // 0.2s: the timed effect is retired, its window restored
+    EXPECT_EQ(effects.get(timedId), nullptr);
+    EXPECT_FALSE(ParticleWindowRegistry::hasActiveEffects(win));
+    EXPECT_EQ(readRow(5), "     status text");
+
+    EXPECT_EQ(effects.tick(0.25f), 0u); // lifetimes over: the other retires once its particles die
+    EXPECT_FALSE(ParticleWindowRegistry::hasActiveEffects(other));
+    EXPECT_TRUE(effects.empty());
+
+    // The blocking helper with no duration animates nothing, however long the particles live
+    Particle ember = spark;
+    ember.setLifetime(1000.0f);
+    spawnBurst(win, {Vec2(10, 5)}, ember, 0.0f);
+    EXPECT_FALSE(ParticleWindowRegistry::hasActiveEffects(win));
+    EXPECT_EQ(readRow(5), "     status text");
+    delwin(other);
+}
+
+TEST_F(HeadlessNcursesTest, ParticleEffect_ParallelUpdateMatchesSingleThreaded)
+{
+    using namespace stevensTerminal::ParticleFX;
+    Particle snow;
+    snow.setPhysics(ParticlePresets::Snow());
+    snow.setModifyChar(true);
+    snow.setCharacter('.');
+    snow.setLifetime(3.0f);
+
+    stevensTerminal::ThreadPool pool(3);
+    auto runEffect = [&](bool parallel) {
+        werase(win);
+        ParticleEffect effect(win, 2024);
+        effect.setThreadPool(pool);
+        effect.setParallelThreshold(parallel ? 0 : SIZE_MAX);
+        effect.spawnRain(0, 79, 30000, snow);
+        for (int step = 0; step < 30; step++) effect.update(1.0f / 30.0f);
+        effect.render();
+        std::string frame;
+        for (int y = 0; y < 24; y++) frame += readRow(y) + "\n";
+        return frame;
+    };
+
+    std::string serial = runEffect(false);
+    EXPECT_EQ(runEffect(true), serial);
+    EXPECT_NE(serial.find('.'), std::string::npos);
+}
+
+TEST(ParticleEmitter, SteadyStreamAccumulatesFractionalRateAtConstantCapacity)
+{
+    using namespace stevensTerminal::ParticleFX;
+    Particle flake;
+    flake.setPhysics(ParticlePresets::Snow());
+    flake.setLifetime(100.0f);
+
+    // 30 particles/s at 60 fps: half a particle per frame, so exactly 30 after one second
+    ParticleEffect effect(nullptr, 5);
+    ParticleEmitter trickle = ParticleEmitter::point(Vec2(10, 10));
+    trickle.setPrototype(flake);
+    trickle.setRate(30.0f);
+    effect.addEmitter(trickle);
+    for (int frame = 0; frame < 60; frame++) effect.update(1.0f / 60.0f);
+    EXPECT_EQ(effect.getParticleCount(), 30u);
+
+    // Snow: 600/s living 1s settles around 600 live particles without growing the pool
+    flake.setLifetime(1.0f);
+    ParticleEffect snowfall(nullptr, 6);
+    ParticleEmitter snow = ParticleEmitter::rect(0, 0, 80, 1);
+    snow.setPrototype(flake);
+    snow.setRate(600.0f);
+    snow.setDirection(std::numbers::pi_v<float> / 2, 0.3f);
+    snowfall.addEmitter(snow);
+    size_t capacity = snowfall.getCapacity();
+    for (int frame = 0; frame < 300; frame++) snowfall.update(1.0f / 60.0f);
+    EXPECT_NEAR(static_cast<double>(snowfall.getParticleCount()), 600.0, 20.0);
+    EXPECT_EQ(snowfall.getCapacity(), capacity);
+
+    // Text masks spawn only on printed characters
+    ParticleEmitter mask = ParticleEmitter::textMask("a b", 4, 2);
+    ParticleRng rng(1);
+    for (int i = 0; i < 50; i++)
+    {
+        Vec2 p = mask.samplePosition(rng);
+        EXPECT_EQ(p.y, 4.0f);
+        EXPECT_TRUE(p.x == 2.0f || p.x == 4.0f);
+    }
+
+    // ...one point per codepoint, moving on by display width: é is two bytes but one cell, 日 two
+    ParticleEmitter wide = ParticleEmitter::textMask("é 日x", 4, 2);
+    std::set<float> columns;
+    for (int i = 0; i < 100; i++) columns.insert(wide.samplePosition(rng).x);
+    EXPECT_EQ(columns, (std::set<float>{2.0f, 4.0f, 6.0f}));
+
+    snowfall.getEmitter(0).setActive(false);
+    EXPECT_FALSE(snowfall.hasActiveEmitters());
+}
+
+TEST_F(HeadlessNcursesTest, ParticleSubCell_MergesParticlesIntoOneGlyphPerCell)
+{
+    using namespace stevensTerminal::ParticleFX;
+    Particle dot;
+    dot.setLifetime(100.0f);
+
+    // Cell (1, 10) spans [9.5, 10.5) x [0.5, 1.5): its top-left and bottom-right dots merge
+    // into one glyph; (5, 20) gets the right column's third dot
+    ParticleEffect effect(win, 1);
+    effect.setRenderMode(RenderMode::Braille);
+    effect.addSpawnPoint(9.6f, 0.6f);
+    effect.addSpawnPoint(10.4f, 1.4f);
+    effect.addSpawnPoint(20.0f, 5.0f);
+    effect.setParticlesPerPoint(3);
+    effect.setSpeedRange(0.0f, 0.0f);
+    effect.spawn(dot);
+    effect.render();
+
+    EXPECT_EQ(effect.getCellsWritten(), 2u); // 9 particles, 2 covered cells
+    EXPECT_EQ(readRow(1), std::string(10, ' ') + "⢁");
+    EXPECT_EQ(readRow(5), std::string(20, ' ') + "⠠");
+
+    // Half blocks: upper and lower halves of one cell merge into a full block
+    ParticleEffect halves(win, 2);
+    halves.setRenderMode(RenderMode::HalfBlock);
+    halves.addSpawnPoint(30.0f, 5.8f);
+    halves.addSpawnPoint(30.0f, 6.2f);
+    halves.setSpeedRange(0.0f, 0.0f);
+    halves.spawn(dot);
+    halves.render();
+    EXPECT_EQ(halves.getCellsWritten(), 1u);
+    EXPECT_EQ(readRow(6), std::string(30, ' ') + "█");
+}
+
+TEST(ParticleSubCell, DominantColorIsTheMajorityPair)
+{
+    using namespace stevensTerminal::ParticleFX;
+    SubCellGrid grid;
+    grid.reset(RenderMode::Braille, 2, 2, SubCellColor::Dominant);
+    grid.plot(0.0f, 0.0f, 3);
+    grid.plot(0.2f, 0.2f, 3);
+    grid.plot(-0.2f, -0.2f, 5);
+    ASSERT_EQ(grid.coveredCells().size(), 1u);
+    EXPECT_EQ(grid.colorPair(0), 3);
+
+    grid.reset(RenderMode::Braille, 2, 2, SubCellColor::Latest);
+    EXPECT_TRUE(grid.coveredCells().empty());
+    grid.plot(1.0f, 1.0f, 3);
+    grid.plot(1.0f, 1.0f, 5);
+    EXPECT_EQ(grid.colorPair(3), 5);
+    EXPECT_FALSE(grid.plot(2.0f, 0.0f, 1)); // outside
+}
+
+TEST(ParticleTrail, IntensityFieldDecaysAndReportsOnlyChangedCells)
+{
+    using namespace stevensTerminal::ParticleFX;
+    IntensityField field;
+    field.resize(4, 8);
+    field.deposit(2.2f, 1.4f, 0.6f);
+    field.deposit(2.0f, 1.0f, 0.6f);     // same cell, saturates
+    EXPECT_FLOAT_EQ(field.intensity(1, 2), 1.0f);
+
+    std::vector<int> levels;
+    EXPECT_EQ(field.diff(4, [&](int, int, uint8_t level) { levels.push_back(level); }), 1u);
+    EXPECT_EQ(levels, std::vector<int>{4});
+    EXPECT_EQ(field.diff(4, [](int, int, uint8_t) {}), 0u); // nothing changed
+
+    EXPECT_EQ(field.decay(0.5f), 1u);
+    EXPECT_FLOAT_EQ(field.intensity(1, 2), 0.5f);
+    EXPECT_EQ(field.diff(4, [](int, int, uint8_t) {}), 1u); // 4 -> 2
+    EXPECT_EQ(field.decay(0.01f, 0.1f), 0u);
+    EXPECT_EQ(field.litCount(), 0u);
+}
+
+TEST_F(HeadlessNcursesTest, ParticleTrail_FadesThroughRampAndRestoresContent)
+{
+    using namespace stevensTerminal::ParticleFX;
+    mvwaddstr(win, 5, 0, "abcdefghijklmnop");
+    ParticleWindowRegistry::registerWindow(win);
+
+    Particle ember;
+    ember.setModifyBg(false);           // draws nothing itself: only its trail shows
+    ember.setLifetime(0.05f);
+    ParticleEffect effect(win, 3);
+    effect.setTrail({{'.', 0}, {'*', 0}, {'#', 0}}, 0.1f, 1.0f);
+    effect.addSpawnPoint(10.0f, 5.0f);
+    effect.setParticlesPerPoint(1);
+    effect.setSpeedRange(0.0f, 0.0f);
+    effect.spawn(ember);
+
+    effect.update(1.0f / 60.0f);
+    effect.render();
+    EXPECT_EQ(readRow(5), "abcdefghij#lmnop");
+    EXPECT_EQ(effect.getCellsWritten(), 1u);
+    effect.render();
+    EXPECT_EQ(effect.getCellsWritten(), 0u); // unchanged level, nothing rewritten
+
+    // The ember dies; one half-life later the cell is at half intensity
+    for (int frame = 0; frame < 6; frame++) effect.update(1.0f / 60.0f);
+    effect.render();
+    EXPECT_EQ(effect.getParticleCount(), 0u);
+    EXPECT_EQ(readRow(5), "abcdefghij*lmnop");
+
+    while (effect.hasVisibleTrail()) effect.update(1.0f / 60.0f);
+    effect.render();
+    EXPECT_EQ(readRow(5), "abcdefghijklmnop");
+    ParticleWindowRegistry::unregisterWindow(win);
+}
+
+TEST_F(HeadlessNcursesTest, ParticleCollision_BouncesOffWindowContent)
+{
+    using namespace stevensTerminal::ParticleFX;
+    mvwaddstr(win, 10, 0, std::string(80, '=').c_str());
+    ParticleWindowRegistry::registerWindow(win);
+
+    const OccupancyMap* occupancy = ParticleWindowRegistry::occupancy(win);
+    ASSERT_NE(occupancy, nullptr);
+    EXPECT_EQ(occupancy->count(), 80u);
+    EXPECT_TRUE(occupancy->occupied(10, 79));
+    EXPECT_FALSE(occupancy->occupied(9, 79));
+
+    // A pebble dropped straight down at the '=' line from row 5 at 10 cells/s
+    Particle pebble;
+    pebble.setPhysics(ParticlePhysics(0.0f, 0.0f, 0.5f, 0.0f));
+    pebble.setModifyChar(true);
+    pebble.setCharacter('o');
+    pebble.setLifetime(100.0f);
+    auto lowestRow = [&](bool collide) {
+        ParticleEffect effect(win, 4);
+        effect.setContentCollision(collide);
+        effect.spawnFountain(Vec2(40.0f, 5.0f), 1, pebble, std::numbers::pi_v<float> / 2, 0.0f, 10.0f, 10.0f);
+        int lowest = 0;
+        for (int frame = 0; frame < 60; frame++) {
+            ParticleWindowRegistry::restoreTouched(win);
+            effect.update(1.0f / 60.0f);
+            effect.render();
+            for (int y = 0; y < 24; y++) {
+                if ((mvwinch(win, y, 40) & A_CHARTEXT) == 'o') lowest = std::max(lowest, y);
+            }
+        }
+        ParticleWindowRegistry::restoreTouched(win);
+        return lowest;
+    };
+
+    EXPECT_EQ(lowestRow(true), 9);     // stopped above the line, then bounced back up
+    EXPECT_GT(lowestRow(false), 10);   // passes straight through without collisions
+    EXPECT_EQ(readRow(10), std::string(80, '='));
+
+    // The bitmap follows the snapshot only when it's re-taken
+    mvwaddstr(win, 10, 0, std::string(80, ' ').c_str());
+    EXPECT_EQ(ParticleWindowRegistry::occupancy(win)->count(), 80u);
+    ParticleWindowRegistry::refreshSnapshot(win);
+    EXPECT_EQ(ParticleWindowRegistry::occupancy(win)->count(), 0u);
+    ParticleWindowRegistry::unregisterWindow(win);
+}
+
+TEST_F(HeadlessNcursesTest, BarRenderer_EighthPrecisionAndSkipsUnchangedBars)
+{
+    stevensTerminal::BarSpec spec;
+    spec.width = 4;
+    spec.fillChar = "█";
+    spec.emptyChar = "░";
+    stevensTerminal::BarRenderer bars(spec);
+
+    // 3/8 of 4 cells = 1.5 cells: one full cell, a half-cell eighth glyph, two empty
+    EXPECT_TRUE(bars.draw(win, 0, 0, 3, 8));
+    EXPECT_EQ(readRow(0), "█▌░░");
+    EXPECT_FALSE(bars.draw(win, 0, 0, 3, 8));       // same fill: skipped
+    EXPECT_FALSE(bars.draw(win, 0, 0, 300, 800));   // same quantized fill: skipped
+    EXPECT_TRUE(bars.draw(win, 0, 0, 13, 32));      // 1.625 cells
+    EXPECT_EQ(readRow(0), "█▋░░");
+
+    // A column of bars in one call; only the changed ones are redrawn
+    std::vector<stevensTerminal::BarValue> values = {{0, 4}, {1, 4}, {4, 4}};
+    EXPECT_EQ(bars.drawColumn(win, 2, 0, values), 3u);
+    EXPECT_EQ(readRow(2), "░░░░");
+    EXPECT_EQ(readRow(3), "█░░░");
+    EXPECT_EQ(readRow(4), "████");
+    values[1].current = 2;
+    EXPECT_EQ(bars.drawColumn(win, 2, 0, values), 1u);
+    EXPECT_EQ(readRow(3), "██░░");
+
+    bars.invalidate(win);
+    EXPECT_EQ(bars.drawColumn(win, 2, 0, values), 3u);
+
+    // Whole-cell precision matches printBar()
+    stevensTerminal::BarRenderer cells(spec, stevensTerminal::BarRenderer::Precision::Cell);
+    cells.draw(win, 6, 0, 3, 8);
+    stevensTerminal::printBar(win, 7, 0, 3, 8, spec);
+    EXPECT_EQ(readRow(6), readRow(7));
+}
+
+TEST(Chart, LargestRemainderSplitAlwaysFillsTheWidth)
+{
+    std::vector<int> widths;
+    std::vector<size_t> order;
+    std::vector<float> thirds = {1.0f, 1.0f, 1.0f};
+    stevensTerminal::largestRemainderSplit(thirds, 10, widths, order);
+    EXPECT_EQ(widths, (std::vector<int>{4, 3, 3}));   // the leftover cell goes to the first tie
+
+    std::vector<float> uneven = {0.155f, 0.345f, 0.5f};
+    stevensTerminal::largestRemainderSplit(uneven, 7, widths, order);
+    EXPECT_EQ(widths, (std::vector<int>{1, 2, 4}));   // 1.085, 2.415, 3.5: remainders .5 > .415 > .085
+
+    std::vector<float> zeros = {0.0f, 0.0f};
+    stevensTerminal::largestRemainderSplit(zeros, 10, widths, order);
+    EXPECT_EQ(widths, (std::vector<int>{0, 0}));
+}
+
+TEST(Chart, BarGraphLabelsShowOneDecimalPlace)
+{
+    using stevensTerminal::BarGraphLabelStyle;
+    stevensTerminal::BarGraphLabelFormat label = stevensTerminal::calculateBarGraphLabel("Cult", 1.0f / 3, 20, true, true);
+    EXPECT_EQ(label.text, "Cult 33.3%");
+    EXPECT_EQ(label.style, BarGraphLabelStyle::TextAndPercentage);
+    EXPECT_EQ(label.width, 10);
+    EXPECT_EQ(label.indent, 5);
+
+    EXPECT_EQ(stevensTerminal::calculateBarGraphLabel("Cult", 0.5f, 20, false, true).text, "50.0%");
+    EXPECT_EQ(stevensTerminal::calculateBarGraphLabel("Cult", 0.0f, 20, false, true).text, "0.0%");
+    EXPECT_EQ(stevensTerminal::calculateBarGraphLabel("Cult", 0.9996f, 20, false, true).text, "100.0%");
+
+    // Too narrow for the text as well: the percentage alone
+    label = stevensTerminal::calculateBarGraphLabel("Cult", 0.125f, 6, true, true);
+    EXPECT_EQ(label.text, "12.5%");
+    EXPECT_EQ(label.style, BarGraphLabelStyle::PercentageOnly);
+}
+
+TEST_F(HeadlessNcursesTest, Chart_StackedBarsHistogramAndGroupedBars)
+{
+    // Segments fill the width exactly and carry labels that fit
+    stevensTerminal::StackedBarChart chart({"Cult", "Town", "Crown"},
+                                           {{"red", "white"}, {"blue", "white"}, {"green", "black"}}, 30);
+    std::vector<float> influence = {1.0f, 1.0f, 1.0f};
+    ASSERT_TRUE(chart.draw(win, 0, 0, influence));
+    EXPECT_EQ(chart.segmentWidths(), (std::vector<int>{10, 10, 10}));
+    EXPECT_EQ(readRow(0), "Cult 33.3%Town 33.3%  33.3%");  // "Crown 33.3%" is one cell too wide
+    influence = {0.0f, 0.0f, 0.0f};
+    EXPECT_FALSE(chart.draw(win, 0, 0, influence));
+
+    // Histogram bars grow up from the bottom row with eighth-block tops
+    stevensTerminal::Histogram histogram(2, 1, 1);
+    std::vector<float> counts = {2.0f, 1.0f, 0.5f};   // 16, 8 and 4 eighths of 2 rows
+    EXPECT_EQ(histogram.draw(win, 4, 0, counts), 3u);
+    EXPECT_EQ(readRow(4), "█");
+    EXPECT_EQ(readRow(5), "█ █ ▄");
+    EXPECT_EQ(histogram.draw(win, 4, 0, counts), 0u);  // unchanged: nothing redrawn
+    counts[2] = 1.0f;
+    EXPECT_EQ(histogram.draw(win, 4, 0, counts), 1u);
+    EXPECT_EQ(readRow(5), "█ █ █");
+
+    // Grouped bars: one row per series, a blank row between groups, one scale for all
+    stevensTerminal::GroupedBarChart grouped({"Mon", "Tue"}, {"red", "blue"}, 4, 5);
+    EXPECT_EQ(grouped.height(), 5);
+    std::vector<float> values = {4.0f, 2.0f, 1.0f, 3.0f};
+    EXPECT_EQ(grouped.draw(win, 10, 0, values), 4u);
+    EXPECT_EQ(readRow(10), "Mon");
+    EXPECT_EQ(grouped.draw(win, 10, 0, values), 0u);
+}
+
+TEST_F(HeadlessNcursesTest, Chart_MultibyteLabelsAreMeasuredInColumns)
+{
+    // "Café 50.0%" is 11 bytes but 10 columns: both segments still fill their 20 cells
+    stevensTerminal::StackedBarChart chart({"Café", "Town"}, {{"red", "white"}, {"blue", "white"}}, 40);
+    std::vector<float> shares = {1.0f, 1.0f};
+    ASSERT_TRUE(chart.draw(win, 0, 0, shares));
+    EXPECT_EQ(chart.segmentWidths(), (std::vector<int>{20, 20}));
+    EXPECT_EQ(getcurx(win), 40);
+    EXPECT_EQ(readRow(0), "     Café 50.0%          Town 50.0%");
+
+    // Group labels are cut and padded by columns, never mid-codepoint
+    // (three bytes of "Crème" would end halfway through the è)
+    stevensTerminal::GroupedBarChart grouped({"Crème brûlée", "Tue"}, {"red"}, 4, 4);
+    std::vector<float> values = {1.0f, 1.0f};
+    grouped.draw(win, 2, 0, values);
+    EXPECT_EQ(readRow(2, 4), "Crè");
+}
+
+TEST_F(HeadlessNcursesTest, Sparkline_DownsamplesHistoryKeepingSpikes)
+{
+    // 64 samples over 4 cells = 8 braille columns of 8 samples each
+    stevensTerminal::Sparkline line(64, 4, 1);
+    for (int i = 0; i < 64; i++) line.push(i == 20 ? 10.0f : 0.0f);
+    EXPECT_EQ(line.size(), 64u);
+    EXPECT_FLOAT_EQ(line.recent(43), 10.0f);
+
+    // Column 2 (samples 16-23) spans 0..10: all four dots of the second cell's left column.
+    // The other columns sit on the bottom dot row.
+    line.draw(win, 0, 0);
+    EXPECT_EQ(readRow(0), "⣀⣇⣀⣀");
+
+    // Pushing past capacity drops the oldest samples; the spike scrolls left and out
+    for (int i = 0; i < 48; i++) line.push(1.0f);
+    line.draw(win, 0, 0);
+    EXPECT_EQ(readRow(0), "⣀⠉⠉⠉");   // two columns of 0s on the bottom, then 1s on top
+
+    // Re-bucketing for a new width keeps the history
+    line.setWidth(2);
+    EXPECT_EQ(line.size(), 64u);
+    line.draw(win, 1, 0);
+    EXPECT_EQ(readRow(1), "⡈⠉");
+
+    // Eighths: each column's maximum as a bar
+    stevensTerminal::Sparkline bars(4, 4, 1, stevensTerminal::Sparkline::Style::Eighths);
+    for (float value : {0.0f, 4.0f, 8.0f, 2.0f}) bars.push(value);
+    bars.draw(win, 3, 0);
+    EXPECT_EQ(readRow(3), " ▄█▂");
+}
+
+TEST_F(HeadlessNcursesTest, Sparkline_ShowsOnlyKeptHistoryAfterWrappingAndResizing)
+{
+    // 100 samples over 30 cells = 60 braille columns of 2 samples: the kept history fills 50 of
+    // them, so the 5 oldest cells stay blank instead of showing evicted samples
+    stevensTerminal::Sparkline line(100, 30, 1);
+    for (int i = 0; i < 1000; i++) line.push(50.0f);
+    line.draw(win, 0, 0);
+    std::string flat;
+    for (int i = 0; i < 25; i++) flat += "⣀";
+    EXPECT_EQ(readRow(0), "     " + flat);
+
+    // 14 columns of 8 samples don't divide 100: the 13 columns holding kept samples are drawn,
+    // all at the same level, and the never-filled one stays blank
+    line.setWidth(7);
+    line.draw(win, 1, 0);
+    EXPECT_EQ(readRow(1), "⢀⣀⣀⣀⣀⣀⣀");
+}
+
+TEST(TimerWheel, FiresOneShotsPeriodicsAndTweensOnTime)
+{
+    stevensTerminal::TimerWheel timers;
+    std::vector<int> order;
+    timers.after(30, [&] { order.push_back(30); });
+    timers.after(5, [&] { order.push_back(5); });
+    auto late = timers.after(100000, [&] { order.push_back(100000); });   // past level 2: cascades down
+    std::vector<uint64_t> periods;
+    auto periodic = timers.every(10, [&](uint64_t period) { periods.push_back(period); });
+    std::vector<float> progress;
+    timers.tween(40, stevensTerminal::easing::linear, [&](float t) { progress.push_back(t); });
+    EXPECT_EQ(timers.size(), 5u);
+
+    EXPECT_EQ(timers.advance(4), 1u);   // the tween's first frame
+    EXPECT_TRUE(order.empty());
+    timers.advance(1);
+    EXPECT_EQ(order, std::vector<int>{5});
+    for (int i = 0; i < 5; i++) timers.advance(5);
+    EXPECT_EQ(order, (std::vector<int>{5, 30}));
+    EXPECT_EQ(periods, (std::vector<uint64_t>{1, 2, 3}));
+
+    // A long stall fires each periodic timer once, skipping to the latest period, and ends the tween
+    timers.advance(70);
+    EXPECT_EQ(periods.back(), 10u);
+    EXPECT_EQ(periods.size(), 4u);
+    EXPECT_FLOAT_EQ(progress.back(), 1.0f);
+    EXPECT_TRUE(std::is_sorted(progress.begin(), progress.end()));
+    EXPECT_EQ(timers.size(), 2u);
+
+    EXPECT_TRUE(timers.cancel(periodic));
+    EXPECT_FALSE(timers.cancel(periodic));
+    timers.advance(100000 - 100 - 1);
+    EXPECT_EQ(order.size(), 2u);
+    timers.advance(1);
+    EXPECT_EQ(order.back(), 100000);
+    EXPECT_FALSE(timers.active(late));
+    EXPECT_TRUE(timers.empty());
+}
+
+TEST(TimerWheel, TimersAddedAfterAnIdleSpellStartFromTheClock)
+{
+    stevensTerminal::TimerWheel timers;
+    timers.service();
+    std::this_thread::sleep_for(std::chrono::milliseconds(300));   // nothing services the wheel
+
+    std::vector<uint64_t> periods;
+    timers.every(100, [&](uint64_t period) { periods.push_back(period); });
+    float progress = -1.0f;
+    auto tween = timers.tween(400, stevensTerminal::easing::linear, [&](float t) { progress = t; });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    timers.service();
+
+    EXPECT_TRUE(periods.empty());   // not due for another ~80ms
+    EXPECT_GT(progress, 0.0f);
+    EXPECT_LT(progress, 0.5f);
+    EXPECT_TRUE(timers.active(tween));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    timers.service();
+    EXPECT_EQ(periods, std::vector<uint64_t>{1});
+}
+
+TEST(TimerWheel, CallbacksMayCancelAndAddTimers)
+{
+    stevensTerminal::TimerWheel timers;
+    int ticks = 0;
+    stevensTerminal::TimerWheel::Id self = 0;
+    self = timers.every(1, [&](uint64_t) {
+        if (++ticks == 3) timers.cancel(self);
+    });
+    int chained = 0;
+    timers.after(2, [&] { timers.after(2, [&] { ++chained; }); });
+    for (int i = 0; i < 10; i++) timers.advance(1);
+    EXPECT_EQ(ticks, 3);
+    EXPECT_EQ(chained, 1);
+    EXPECT_TRUE(timers.empty());
+
+    // Ping-pong tweens run up to 1 and back down
+    std::vector<float> pulse;
+    auto id = timers.tween(4, stevensTerminal::easing::linear, [&](float t) { pulse.push_back(t); },
+                           stevensTerminal::TimerWheel::Repeat::PingPong);
+    for (int i = 0; i < 8; i++) timers.advance(1);
+    EXPECT_EQ(pulse, (std::vector<float>{0.25f, 0.5f, 0.75f, 1.0f, 0.75f, 0.5f, 0.25f, 0.0f}));
+    EXPECT_TRUE(timers.active(id));
+}
+
+TEST_F(HeadlessNcursesTest, TimerWheel_AnimatesSpinnerWithoutACallerFrameCounter)
+{
+    stevensTerminal::TimerWheel timers;
+    auto spinner = stevensTerminal::animateSpinner(timers, win, 0, 0, stevensTerminal::spinners::pipe, 100);
+    EXPECT_EQ(readRow(0).substr(0, 1), "|");
+    timers.advance(100);
+    EXPECT_EQ(readRow(0).substr(0, 1), "/");
+    timers.advance(250);   // a stall: skips straight to the current frame
+    EXPECT_EQ(readRow(0).substr(0, 1), "\\");
+    timers.cancel(spinner);
+    timers.advance(100);
+    EXPECT_EQ(readRow(0).substr(0, 1), "\\");
+}
+
+TEST_F(HeadlessNcursesTest, AnimatedPalette_RewritesBoundCellsWhenColoursAreFixed)
+{
+    // xterm: 8 fixed colours and every pair taken by the library, so only the Rewrite fallback
+    start_color();
+    stevensTerminal::Colors::curses_setup_colorCodes();
+    stevensTerminal::Colors::curses_setup_colorPairs();
+    const int red = stevensTerminal::Colors::lookupColorPairByName("red", "black");
+    const int blue = stevensTerminal::Colors::lookupColorPairByName("blue", "black");
+    {
+        stevensTerminal::AnimatedPalette palette(2);
+        ASSERT_EQ(palette.mode(), stevensTerminal::AnimatedPalette::Mode::Rewrite);
+        int alert = palette.reserve({220, 0, 0});
+        EXPECT_EQ(palette.pair(alert), red);
+
+        palette.use(win, alert);
+        wattron(win, A_BOLD);
+        mvwaddstr(win, 0, 0, "AL");
+        wattroff(win, A_BOLD);
+        waddstr(win, "ERT");
+        mvwaddstr(win, 1, 0, "ALERT");   // drawn with the slot but never bound
+        wcolor_set(win, 0, nullptr);
+        mvwaddstr(win, 0, 5, " ok");
+        palette.bind(alert, win, 0, 0, 1, 10);
+
+        palette.set(alert, {200, 10, 10});   // still nearest to red: nothing to rewrite
+        EXPECT_EQ(palette.cellsRewritten(), 0u);
+
+        palette.set(alert, {0, 0, 230});
+        EXPECT_EQ(palette.pair(alert), blue);
+        EXPECT_EQ(palette.cellsRewritten(), 5u);
+        EXPECT_EQ(PAIR_NUMBER(mvwinch(win, 0, 0)), blue);
+        EXPECT_TRUE(mvwinch(win, 0, 1) & A_BOLD);
+        EXPECT_EQ(PAIR_NUMBER(mvwinch(win, 0, 4)), blue);
+        EXPECT_EQ(PAIR_NUMBER(mvwinch(win, 0, 6)), 0);
+        EXPECT_EQ(PAIR_NUMBER(mvwinch(win, 1, 0)), red);
+        EXPECT_EQ(readRow(0), "ALERT ok");
+    }
+    stevensTerminal::Colors::curses_colorPairs.clear();
+    stevensTerminal::Colors::curses_colors.clear();
+}
+
+TEST(AnimatedPalette, RedefinesColoursOrPairsWhenTheTerminalAllows)
+{
+    FILE* devnull = fopen("/dev/null", "w");
+    SCREEN* screen = newterm("xterm-256color", devnull, stdin);
+    set_term(screen);
+    start_color();
+    stevensTerminal::Colors::curses_setup_colorCodes();
+    stevensTerminal::Colors::curses_setup_colorPairs();
+    {
+        stevensTerminal::AnimatedPalette palette(2);
+        ASSERT_EQ(palette.mode(), stevensTerminal::AnimatedPalette::Mode::Palette);
+        int glow = palette.reserve({0, 0, 0});
+        short fg, bg;
+        pair_content(palette.pair(glow), &fg, &bg);
+        EXPECT_GE(fg, 16);   // a colour of its own, above the named ones
+
+        // Tween to white on a timer wheel; the colour itself changes, the pair stays put
+        stevensTerminal::TimerWheel timers;
+        const short pairBefore = palette.pair(glow);
+        palette.animate(timers, glow, {255, 255, 255}, 100, stevensTerminal::easing::linear);
+        timers.advance(50);
+        short r, g, b;
+        color_content(fg, &r, &g, &b);
+        EXPECT_NEAR(r, 500, 5);
+        timers.advance(50);
+        color_content(fg, &r, &g, &b);
+        EXPECT_EQ(r, 1000);
+        EXPECT_EQ(palette.color(glow), (stevensTerminal::Rgb{255, 255, 255}));
+        EXPECT_EQ(palette.pair(glow), pairBefore);
+
+        // Pairs: no colour changes, the slot's own pair follows the nearest named colour
+        stevensTerminal::AnimatedPalette pairs(2, stevensTerminal::AnimatedPalette::Mode::Pairs);
+        ASSERT_EQ(pairs.mode(), stevensTerminal::AnimatedPalette::Mode::Pairs);
+        int warn = pairs.reserve({0, 0, 230});
+        EXPECT_NE(pairs.pair(warn), palette.pair(glow));
+        pair_content(pairs.pair(warn), &fg, &bg);
+        EXPECT_EQ(fg, stevensTerminal::Colors::curses_colors.at("blue"));
+        pairs.set(warn, {250, 250, 20});
+        pair_content(pairs.pair(warn), &fg, &bg);
+        EXPECT_EQ(fg, stevensTerminal::Colors::curses_colors.at("bright-yellow"));
+    }
+    stevensTerminal::Colors::curses_colorPairs.clear();
+    stevensTerminal::Colors::curses_colors.clear();
+    endwin();
+    delscreen(screen);
+    fclose(devnull);
+}
+
 /***** INPUT VALIDATION COMPREHENSIVE TESTS *****/
 TEST(InputValidation, inputWithinResponseRange_all_valid_numbers)
 {